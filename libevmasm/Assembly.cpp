@@ -32,6 +32,9 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+#include <libsolutil/TimeReport.h>
+
 #include <fstream>
 #include <json/json.h>
 
@@ -75,7 +78,7 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 	if (!_location.hasText() || _sourceCodes.empty())
 		return "";
 
-	auto it = _sourceCodes.find(_location.source->name());
+	auto it = _sourceCodes.find(*_location.sourceName);
 	if (it == _sourceCodes.end())
 		return "";
 
@@ -149,8 +152,8 @@ public:
 		if (!m_location.isValid())
 			return;
 		m_out << m_prefix << "    /*";
-		if (m_location.source)
-			m_out << " \"" + m_location.source->name() + "\"";
+		if (m_location.sourceName)
+			m_out << " \"" + *m_location.sourceName + "\"";
 		if (m_location.hasText())
 			m_out << ":" << to_string(m_location.start) + ":" + to_string(m_location.end);
 		m_out << "  " << locationFromSources(m_sourceCodes, m_location);
@@ -232,9 +235,9 @@ Json::Value Assembly::assemblyJSON(map<string, unsigned> const& _sourceIndices)
 	for (AssemblyItem const& i: m_items)
 	{
 		int sourceIndex = -1;
-		if (i.location().source)
+		if (i.location().sourceName)
 		{
-			auto iter = _sourceIndices.find(i.location().source->name());
+			auto iter = _sourceIndices.find(*i.location().sourceName);
 			if (iter != _sourceIndices.end())
 				sourceIndex = static_cast<int>(iter->second);
 		}
@@ -396,25 +399,61 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+bool Assembly::subAssembliesAreDisjoint() const
+{
+	// Maps every assembly reached so far to the sub-assembly it is nested in.
+	map<Assembly const*, size_t> owners;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		vector<Assembly const*> toVisit{m_subs[subId].get()};
+		while (!toVisit.empty())
+		{
+			Assembly const* assembly = toVisit.back();
+			toVisit.pop_back();
+			auto [it, inserted] = owners.emplace(assembly, subId);
+			if (!inserted)
+			{
+				if (it->second != subId)
+					return false;
+				continue;
+			}
+			for (auto const& sub: assembly->m_subs)
+				toVisit.emplace_back(sub.get());
+		}
+	}
+	return true;
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
-	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	// Run optimisation for sub-assemblies. They can be optimised concurrently unless they
+	// share nested assemblies. The tag replacements are applied in order of the sub-assemblies
+	// afterwards, so the result does not depend on the order in which they finish.
+	OptimiserSettings subSettings = _settings;
+	// Disable creation mode for sub-assemblies.
+	subSettings.isCreation = false;
+	unsigned parallelism = 1;
+	if (m_subs.size() > 1 && _settings.parallelism > 1 && subAssembliesAreDisjoint())
 	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		parallelism = _settings.parallelism;
+		// Nested sub-assemblies are optimised on the thread of their parent.
+		subSettings.parallelism = 1;
 	}
 
+	vector<set<size_t>> subTagsReferenced;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		subTagsReferenced.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	parallelFor(m_subs.size(), parallelism, [&](size_t _subId) {
+		subTagReplacements[_subId] = m_subs[_subId]->optimiseInternal(subSettings, move(subTagsReferenced[_subId]));
+	});
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		// Apply the replacements (can be empty).
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
+
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
@@ -423,6 +462,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runJumpdestRemover)
 		{
+			TimeReport::Timer timer("EVM optimiser", "JumpdestRemover");
 			JumpdestRemover jumpdestOpt{m_items};
 			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
 				count++;
@@ -430,6 +470,7 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runPeephole)
 		{
+			TimeReport::Timer timer("EVM optimiser", "PeepholeOptimiser");
 			PeepholeOptimiser peepOpt{m_items};
 			while (peepOpt.optimise())
 			{
@@ -441,6 +482,7 @@ map<u256, u256> Assembly::optimiseInternal(
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
+			TimeReport::Timer timer("EVM optimiser", "BlockDeduplicator");
 			BlockDeduplicator deduplicator{m_items};
 			if (deduplicator.deduplicate())
 			{
@@ -469,6 +511,7 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			TimeReport::Timer timer("EVM optimiser", "CommonSubexpressionEliminator");
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
@@ -515,12 +558,15 @@ map<u256, u256> Assembly::optimiseInternal(
 	}
 
 	if (_settings.runConstantOptimiser)
+	{
+		TimeReport::Timer timer("EVM optimiser", "ConstantOptimiser");
 		ConstantOptimisationMethod::optimiseConstants(
 			_settings.isCreation,
 			_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
 			_settings.evmVersion,
 			*this
 		);
+	}
 
 	return tagReplacements;
 }
@@ -534,6 +580,8 @@ LinkerObject const& Assembly::assemble() const
 	// Otherwise ensure the object is actually clear.
 	assertThrow(m_assembledObject.linkReferences.empty(), AssemblyException, "Unexpected link references.");
 
+	TimeReport::Timer timer("EVM assembly");
+
 	LinkerObject& ret = m_assembledObject;
 
 	size_t subTagSize = 1;
@@ -645,7 +693,7 @@ LinkerObject const& Assembly::assemble() const
 		{
 			assertThrow(i.data() <= numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			unsigned b = max<unsigned>(1, util::bytesRequired(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
@@ -115,6 +115,8 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = 200;
+		/// Maximum number of threads used to optimise the sub-assemblies concurrently.
+		unsigned parallelism = 1;
 	};
 
 	/// Modify and return the current assembly such that creation and execution gas usage
@@ -154,6 +156,9 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// @returns true if no assembly is nested in more than one of the sub-assemblies, i.e.
+	/// if the sub-assemblies can be optimised concurrently.
+	bool subAssembliesAreDisjoint() const;
 
 	unsigned bytesRequired(unsigned subTagSize) const;
 
@@ -26,6 +26,7 @@
 #include <liblangutil/SourceLocation.h>
 
 #include <fstream>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -87,8 +88,8 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength) const
 	case PushImmutable:
 		return 1 + 32;
 	case AssignImmutable:
-		if (m_immutableOccurrences)
-			return 1 + (3 + 32) * *m_immutableOccurrences;
+		if (m_immutableOccurrences != c_unsetValue)
+			return 1 + (3 + 32) * m_immutableOccurrences;
 		else
 			return 1 + (3 + 32) * 1024; // 1024 occurrences are beyond the maximum code size anyways.
 	default:
@@ -330,6 +331,8 @@ std::string AssemblyItem::computeSourceMapping(
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Source indices by interned source name, so that every name is looked up only once.
+	unordered_map<string const*, int> sourceIndices;
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
@@ -337,10 +340,15 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && _sourceIndicesMap.count(location.source->name()) ?
-			static_cast<int>(_sourceIndicesMap.at(location.source->name())) :
-			-1;
+		int sourceIndex = -1;
+		if (location.sourceName)
+		{
+			auto [it, inserted] = sourceIndices.try_emplace(location.sourceName, -1);
+			if (inserted)
+				if (auto index = _sourceIndicesMap.find(*location.sourceName); index != _sourceIndicesMap.end())
+					it->second = static_cast<int>(index->second);
+			sourceIndex = it->second;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
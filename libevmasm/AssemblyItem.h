@@ -28,6 +28,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <sstream>
 
 namespace solidity::evmasm
@@ -57,7 +59,7 @@ using AssemblyItems = std::vector<AssemblyItem>;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -73,7 +75,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -92,8 +94,25 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, util::Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = static_cast<uint64_t>(_data);
+			m_largeData.reset();
+		}
+		else
+		{
+			m_smallData = 0;
+			m_largeData = std::make_shared<u256 const>(_data);
+		}
+	}
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -105,8 +124,10 @@ public:
 			return false;
 		if (type() == Operation)
 			return instruction() == _other.instruction();
+		else if (m_largeData && _other.m_largeData)
+			return m_largeData == _other.m_largeData || *m_largeData == *_other.m_largeData;
 		else
-			return data() == _other.data();
+			return !m_largeData && !_other.m_largeData && m_smallData == _other.m_smallData;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -116,8 +137,13 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (m_largeData && _other.m_largeData)
+			return *m_largeData < *_other.m_largeData;
+		else if (m_largeData || _other.m_largeData)
+			// Small values are never stored out of line, so they are smaller than all large ones.
+			return !m_largeData;
 		else
-			return data() < _other.data();
+			return m_smallData < _other.m_smallData;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -149,26 +175,47 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const
+	{
+		assertThrow(_value < c_unsetValue, util::Exception, "Pushed value too large.");
+		m_pushedValue = static_cast<uint32_t>(_value);
+	}
+	std::optional<u256> pushedValue() const
+	{
+		if (m_pushedValue == c_unsetValue)
+			return std::nullopt;
+		return u256(m_pushedValue);
+	}
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = std::make_shared<size_t>(_n); }
+	void setImmutableOccurrences(size_t _n) const
+	{
+		assertThrow(_n < c_unsetValue, util::Exception, "Too many immutable occurrences.");
+		m_immutableOccurrences = static_cast<uint32_t>(_n);
+	}
 
 private:
+	/// Value of m_pushedValue and m_immutableOccurrences before they are set.
+	static uint32_t constexpr c_unsetValue = std::numeric_limits<uint32_t>::max();
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable uint32_t m_pushedValue = c_unsetValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::shared_ptr<size_t> m_immutableOccurrences;
+	mutable uint32_t m_immutableOccurrences = c_unsetValue;
+	/// Data of the item if it fits into 64 bits, i.e. if m_largeData is not set.
+	/// Only valid if m_type != Operation.
+	uint64_t m_smallData = 0;
+	/// Data of the item if it does not fit into 64 bits (e.g. hashes and large constants),
+	/// shared by all copies of the item.
+	std::shared_ptr<u256 const> m_largeData;
+	langutil::SourceLocation m_location;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
@@ -27,8 +27,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <algorithm>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -49,46 +49,39 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	auto blocksEqual = [&](size_t _i, size_t _j)
 	{
-		if (_i == _j)
-			return false;
-
 		// To compare recursive loops, we have to already unify PushTag opcodes of the
 		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
+		AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+		AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
 
 		using diff_type = BlockIterator::difference_type;
 		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
 		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
 		BlockIterator end{m_items.end(), m_items.end()};
 
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
-
-		return std::lexicographical_compare(first, end, second, end);
+		for (++first, ++second; first != end && second != end; ++first, ++second)
+			if (*first != *second)
+				return false;
+		return first == end && second == end;
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		// Blocks are only compared if the hashes of their suffixes are equal.
+		// The hashes of all suffixes are computed in a single backwards pass.
+		vector<uint64_t> hashes = suffixHashes(pushSelf);
+		unordered_map<uint64_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[hashes[i]];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) { return blocksEqual(_j, i); });
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -99,6 +92,83 @@ bool BlockDeduplicator::deduplicate()
 	return iterations > 0;
 }
 
+vector<uint64_t> BlockDeduplicator::suffixHashes(AssemblyItem const& _pushSelf) const
+{
+	uint64_t const multiplier = 0x100000001b3;
+	auto itemHash = [&](AssemblyItem const& _item)
+	{
+		uint64_t hash = static_cast<uint64_t>(_item.type());
+		if (_item.type() == Operation)
+			hash = hash * multiplier + static_cast<uint8_t>(_item.instruction());
+		else
+		{
+			u256 data = _item.data();
+			for (size_t i = 0; i < 4; ++i, data >>= 64)
+				hash = hash * multiplier + static_cast<uint64_t>(data);
+		}
+		return hash;
+	};
+	auto endsBlock = [](AssemblyItem const& _item)
+	{
+		return SemanticInformation::altersControlFlow(_item) && _item != AssemblyItem{Instruction::JUMPI};
+	};
+
+	size_t const size = m_items.size();
+	// The suffix starting at position k consists of the items that are not tags, up to and including
+	// the first item that ends the block. Its hash is the sum of hash(item) * multiplier^distance.
+	vector<uint64_t> hashes(size + 1, 0);
+	// Position of the last item of the suffix starting at position k.
+	vector<size_t> blockEnd(size + 1, size);
+	for (size_t k = size; k-- > 0;)
+	{
+		AssemblyItem const& item = m_items[k];
+		if (item.type() == Tag)
+		{
+			hashes[k] = hashes[k + 1];
+			blockEnd[k] = blockEnd[k + 1];
+		}
+		else if (endsBlock(item))
+		{
+			hashes[k] = itemHash(item);
+			blockEnd[k] = k;
+		}
+		else
+		{
+			hashes[k] = itemHash(item) + multiplier * hashes[k + 1];
+			blockEnd[k] = blockEnd[k + 1];
+		}
+	}
+
+	// Number of items before position k that are not tags, and the powers of the multiplier.
+	vector<size_t> itemsBefore(size + 1, 0);
+	vector<uint64_t> powers(size + 1, 1);
+	map<u256, vector<size_t>> pushTagPositions;
+	for (size_t k = 0; k < size; ++k)
+	{
+		itemsBefore[k + 1] = itemsBefore[k] + (m_items[k].type() == Tag ? 0 : 1);
+		powers[k + 1] = powers[k] * multiplier;
+		if (m_items[k].type() == PushTag)
+			pushTagPositions[m_items[k].data()].push_back(k);
+	}
+
+	// Inside the suffix of a tag, pushes of the tag itself are treated as pushes of the
+	// virtual tag @a _pushSelf.
+	uint64_t const pushSelfHash = itemHash(_pushSelf);
+	for (size_t i = 0; i < size; ++i)
+		if (m_items[i].type() == Tag)
+		{
+			auto positions = pushTagPositions.find(m_items[i].data());
+			if (positions == pushTagPositions.end())
+				continue;
+			uint64_t const difference = pushSelfHash - itemHash(m_items[i].pushTag());
+			for (size_t position: positions->second)
+				if (i < position && position <= blockEnd[i])
+					hashes[i] += difference * powers[itemsBefore[position] - itemsBefore[i]];
+		}
+
+	return hashes;
+}
+
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
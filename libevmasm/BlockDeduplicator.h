@@ -61,6 +61,11 @@ public:
 	);
 
 private:
+	/// @returns, for each position, a hash of the items compared by deduplicate() for a tag
+	/// at that position, where pushes of that tag are replaced by @a _pushSelf.
+	/// Runs in linear time.
+	std::vector<uint64_t> suffixHashes(AssemblyItem const& _pushSelf) const;
+
 	/// Iterator that skips tags and skips to the end if (all branches of) the control
 	/// flow does not continue to the next instruction.
 	/// If the arguments are supplied to the constructor, replaces items on the fly.
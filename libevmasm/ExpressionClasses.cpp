@@ -51,8 +51,12 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+	{
+		u256 data = item->data();
+		u256 otherData = _other.item->data();
+		return std::tie(data, arguments, sequenceNumber) <
+			std::tie(otherData, _other.arguments, _other.sequenceNumber);
+	}
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -133,7 +137,7 @@ bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionC
 bool ExpressionClasses::knownToBeDifferentBy32(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is at least 32 away from zero.
-	u256 const* v = knownConstant(find(Instruction::SUB, {_a, _b}));
+	optional<u256> v = knownConstant(find(Instruction::SUB, {_a, _b}));
 	// forbidden interval is ["-31", 31]
 	return v && *v + 31 > u256(62);
 }
@@ -148,14 +152,14 @@ bool ExpressionClasses::knownNonZero(Id _c)
 	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this);
 }
 
-u256 const* ExpressionClasses::knownConstant(Id _c)
+optional<u256> ExpressionClasses::knownConstant(Id _c)
 {
 	map<unsigned, Expression const*> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
-		return nullptr;
-	return &constant.d();
+		return nullopt;
+	return constant.d();
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -183,7 +187,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the matched expressions while matching, so every thread needs its own.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -372,7 +372,7 @@ KnownState::Id KnownState::applyKeccak256(
 {
 	AssemblyItem keccak256Item(Instruction::KECCAK256, _location);
 	// Special logic if length is a short constant, otherwise we cannot tell.
-	u256 const* l = m_expressionClasses->knownConstant(_length);
+	optional<u256> l = m_expressionClasses->knownConstant(_length);
 	// unknown or too large length
 	if (!l || *l > 128)
 		return m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
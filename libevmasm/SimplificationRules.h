@@ -115,7 +115,7 @@ public:
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d() const { return matchGroupValue().item->data(); }
 
 	std::string toString() const;
 
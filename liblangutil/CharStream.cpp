@@ -102,6 +102,21 @@ string CharStream::lineAtPosition(int _position) const
 	return line;
 }
 
+string CharStream::text(SourceLocation const& _location) const
+{
+	assertThrow(_location.sourceName && *_location.sourceName == m_name, SourceLocationError, "Requested text from a different source.");
+	assertThrow(contains(_location), SourceLocationError, "Invalid source location.");
+	return m_source.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
+}
+
+bool CharStream::contains(SourceLocation const& _location) const
+{
+	return
+		_location.hasText() &&
+		*_location.sourceName == m_name &&
+		_location.end <= static_cast<int>(m_source.length());
+}
+
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
 	using size_type = string::size_type;
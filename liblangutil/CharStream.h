@@ -59,6 +59,7 @@
 
 namespace solidity::langutil
 {
+struct SourceLocation;
 
 /**
  * Bidirectional stream of characters.
@@ -90,6 +91,12 @@ public:
 	std::string const& source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
+	/// @returns the part of the source text that @a _location refers to.
+	/// Throws if @a _location does not refer to a range of this source.
+	std::string text(SourceLocation const& _location) const;
+	/// @returns true if @a _location refers to a range of this source.
+	bool contains(SourceLocation const& _location) const;
+
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
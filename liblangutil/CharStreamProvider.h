@@ -0,0 +1,74 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Interface to retrieve the source text of a compilation by the names of its sources.
+ */
+
+#pragma once
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <string>
+
+namespace solidity::langutil
+{
+
+/**
+ * Provides the character streams of the sources of a compilation. Source locations only refer
+ * to sources by name, so a provider is needed wherever the text of a location is printed.
+ */
+class CharStreamProvider
+{
+public:
+	virtual ~CharStreamProvider() = default;
+
+	/// @returns the character stream of the source called @a _sourceName or nullptr if there
+	/// is no such source.
+	virtual CharStream const* charStream(std::string const& _sourceName) const = 0;
+
+	/// @returns the part of the source text that @a _location refers to.
+	/// Throws if the source of @a _location is not known.
+	std::string text(SourceLocation const& _location) const
+	{
+		CharStream const* source = _location.sourceName ? charStream(*_location.sourceName) : nullptr;
+		assertThrow(source, SourceLocationError, "Requested text from an unknown source.");
+		return source->text(_location);
+	}
+};
+
+/**
+ * Provides a single character stream, for example the one of a code snippet.
+ */
+class SingletonCharStreamProvider: public CharStreamProvider
+{
+public:
+	explicit SingletonCharStreamProvider(CharStream const& _charStream):
+		m_charStream(_charStream)
+	{}
+
+	CharStream const* charStream(std::string const& _sourceName) const override
+	{
+		return _sourceName == m_charStream.name() ? &m_charStream : nullptr;
+	}
+
+private:
+	CharStream const& m_charStream;
+};
+
+}
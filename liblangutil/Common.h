@@ -14,9 +14,53 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+
 namespace solidity::langutil
 {
 
+namespace detail
+{
+
+/// Classes of characters, combined as bit flags in characterClasses.
+enum CharacterClass: uint8_t
+{
+	HexDigitClass = 1,
+	WhiteSpaceClass = 2,
+	IdentifierStartClass = 4,
+	IdentifierPartClass = 8
+};
+
+constexpr std::array<uint8_t, 256> makeCharacterClasses()
+{
+	std::array<uint8_t, 256> classes{};
+	auto add = [&](char _first, char _last, uint8_t _classes) {
+		for (auto c = static_cast<uint8_t>(_first); c <= static_cast<uint8_t>(_last); ++c)
+			classes[c] = static_cast<uint8_t>(classes[c] | _classes);
+	};
+	add('0', '9', HexDigitClass | IdentifierPartClass);
+	add('a', 'f', HexDigitClass);
+	add('A', 'F', HexDigitClass);
+	add('a', 'z', IdentifierStartClass | IdentifierPartClass);
+	add('A', 'Z', IdentifierStartClass | IdentifierPartClass);
+	add('_', '_', IdentifierStartClass | IdentifierPartClass);
+	add('$', '$', IdentifierStartClass | IdentifierPartClass);
+	for (char c: {' ', '\n', '\t', '\r'})
+		add(c, c, WhiteSpaceClass);
+	return classes;
+}
+
+/// The classes of every character, so that testing for a class is a single lookup.
+inline constexpr std::array<uint8_t, 256> characterClasses = makeCharacterClasses();
+
+inline bool hasClass(char c, CharacterClass _class)
+{
+	return (characterClasses[static_cast<uint8_t>(c)] & _class) != 0;
+}
+
+}
+
 inline bool isDecimalDigit(char c)
 {
 	return '0' <= c && c <= '9';
@@ -24,25 +68,22 @@ inline bool isDecimalDigit(char c)
 
 inline bool isHexDigit(char c)
 {
-	return
-		isDecimalDigit(c) ||
-		('a' <= c && c <= 'f') ||
-		('A' <= c && c <= 'F');
+	return detail::hasClass(c, detail::HexDigitClass);
 }
 
 inline bool isWhiteSpace(char c)
 {
-	return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+	return detail::hasClass(c, detail::WhiteSpaceClass);
 }
 
 inline bool isIdentifierStart(char c)
 {
-	return c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+	return detail::hasClass(c, detail::IdentifierStartClass);
 }
 
 inline bool isIdentifierPart(char c)
 {
-	return isIdentifierStart(c) || isDecimalDigit(c);
+	return detail::hasClass(c, detail::IdentifierPartClass);
 }
 
 inline int hexValue(char c)
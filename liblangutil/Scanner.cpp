@@ -137,6 +137,7 @@ private:
 void Scanner::reset(CharStream _source)
 {
 	m_source = make_shared<CharStream>(std::move(_source));
+	m_sourceName = internSourceName(m_source->name());
 	reset();
 }
 
@@ -144,6 +145,7 @@ void Scanner::reset(shared_ptr<CharStream> _source)
 {
 	solAssert(_source.get() != nullptr, "You MUST provide a CharStream when resetting.");
 	m_source = std::move(_source);
+	m_sourceName = internSourceName(m_source->name());
 	reset();
 }
 
@@ -256,11 +258,24 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+template <typename Predicate>
+void Scanner::advanceWhile(Predicate const& _predicate)
+{
+	// The current character is tested separately because error recovery can leave it out of
+	// sync with the position in the source.
+	if (isSourcePastEndOfInput() || !_predicate(m_char))
+		return;
+	string const& source = m_source->source();
+	size_t position = sourcePos() + 1;
+	while (position < source.size() && _predicate(source[position]))
+		++position;
+	m_char = m_source->setPosition(position);
+}
+
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
+	advanceWhile(isWhiteSpace);
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -268,8 +283,8 @@ bool Scanner::skipWhitespace()
 bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char) && !isUnicodeLinebreak())
-		advance();
+	// These are all the whitespace characters that are not line breaks.
+	advanceWhile([](char c) { return c == ' ' || c == '\t'; });
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -278,6 +293,23 @@ bool Scanner::skipWhitespaceExceptUnicodeLinebreak()
 namespace
 {
 
+/// @returns true iff there is a unicode line break at @a _position of @a _source.
+bool isUnicodeLinebreak(string const& _source, size_t _position)
+{
+	auto byte = [&](size_t _offset) { return uint8_t(_source[_position + _offset]); };
+	if (0x0a <= byte(0) && byte(0) <= 0x0d)
+		// line feed, vertical tab, form feed, carriage return
+		return true;
+	if (_position + 1 < _source.size() && byte(0) == 0xc2 && byte(1) == 0x85)
+		// NEL - U+0085, C2 85 in utf8
+		return true;
+	if (_position + 2 < _source.size() && byte(0) == 0xe2 && byte(1) == 0x80 && (byte(2) == 0xa8 || byte(2) == 0xa9))
+		// LS - U+2028, E2 80 A8  in utf8
+		// PS - U+2029, E2 80 A9  in utf8
+		return true;
+	return false;
+}
+
 /// Tries to scan for an RLO/LRO/RLE/LRE/PDF and keeps track of script writing direction override depth.
 ///
 /// @returns ScannerError::NoError in case of successful parsing and directional encodings are paired
@@ -294,6 +326,10 @@ static ScannerError validateBiDiMarkup(CharStream& _stream, size_t _startPositio
 	};
 
 	size_t endPosition = _stream.position();
+	// All the sequences start with the same byte, so most comments and strings can be skipped
+	// with a single search.
+	if (_stream.source().find('\xE2', _startPosition) >= endPosition)
+		return ScannerError::NoError;
 	_stream.setPosition(_startPosition);
 
 	int directionOverrideDepth = 0;
@@ -322,9 +358,11 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source->position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	string const& source = m_source->source();
+	size_t position = startPosition;
+	while (position < source.size() && !langutil::isUnicodeLinebreak(source, position))
+		++position;
+	m_char = m_source->setPosition(position);
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -402,26 +440,22 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source->position();
-	while (!isSourcePastEndOfInput())
+	size_t const endPosition = m_source->source().find("*/", startPosition);
+	if (endPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source->setPosition(m_source->source().size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	m_char = m_source->setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(*m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	// Consume the '/'. This way all multi-line comments are treated as whitespace.
+	m_char = m_source->setPosition(endPosition + 2);
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -496,7 +530,7 @@ Token Scanner::scanSlash()
 				return skipSingleLineComment();
 			// doxygen style /// comment
 			m_skippedComments[NextNext].location.start = firstSlashPosition;
-			m_skippedComments[NextNext].location.source = m_source;
+			m_skippedComments[NextNext].location.sourceName = m_sourceName;
 			m_skippedComments[NextNext].token = Token::CommentLiteral;
 			m_skippedComments[NextNext].location.end = static_cast<int>(scanSingleLineDocComment());
 			return Token::Whitespace;
@@ -525,7 +559,7 @@ Token Scanner::scanSlash()
 				return skipMultiLineComment();
 			// we actually have a multiline documentation comment
 			m_skippedComments[NextNext].location.start = firstSlashPosition;
-			m_skippedComments[NextNext].location.source = m_source;
+			m_skippedComments[NextNext].location.sourceName = m_sourceName;
 			Token comment = scanMultiLineDocComment();
 			m_skippedComments[NextNext].location.end = static_cast<int>(sourcePos());
 			m_skippedComments[NextNext].token = comment;
@@ -765,7 +799,7 @@ void Scanner::scanToken()
 	}
 	while (token == Token::Whitespace);
 	m_tokens[NextNext].location.end = static_cast<int>(sourcePos());
-	m_tokens[NextNext].location.source = m_source;
+	m_tokens[NextNext].location.sourceName = m_sourceName;
 	m_tokens[NextNext].token = token;
 	m_tokens[NextNext].extendedTokenInfo = make_tuple(m, n);
 }
@@ -816,19 +850,7 @@ bool Scanner::scanEscape()
 
 bool Scanner::isUnicodeLinebreak()
 {
-	if (0x0a <= m_char && m_char <= 0x0d)
-		// line feed, vertical tab, form feed, carriage return
-		return true;
-	if (!m_source->isPastEndOfInput(1) && uint8_t(m_source->get(0)) == 0xc2 && uint8_t(m_source->get(1)) == 0x85)
-		// NEL - U+0085, C2 85 in utf8
-		return true;
-	if (!m_source->isPastEndOfInput(2) && uint8_t(m_source->get(0)) == 0xe2 && uint8_t(m_source->get(1)) == 0x80 && (
-		uint8_t(m_source->get(2)) == 0xa8 || uint8_t(m_source->get(2)) == 0xa9
-	))
-		// LS - U+2028, E2 80 A8  in utf8
-		// PS - U+2029, E2 80 A9  in utf8
-		return true;
-	return false;
+	return langutil::isUnicodeLinebreak(m_source->source(), sourcePos());
 }
 
 Token Scanner::scanString(bool const _isUnicode)
@@ -916,9 +938,9 @@ void Scanner::scanDecimalDigits()
 		return;
 
 	// May continue with decimal digit or underscore for grouping.
-	do
-		addLiteralCharAndAdvance();
-	while (!m_source->isPastEndOfInput() && (isDecimalDigit(m_char) || m_char == '_'));
+	size_t const startPosition = sourcePos();
+	advanceWhile([](char c) { return isDecimalDigit(c) || c == '_'; });
+	m_tokens[NextNext].literal.append(source(), startPosition, sourcePos() - startPosition);
 
 	// Defer further validation of underscore to SyntaxChecker.
 }
@@ -951,8 +973,10 @@ Token Scanner::scanNumber(char _charSeen)
 				if (!isHexDigit(m_char))
 					return setError(ScannerError::IllegalHexDigit); // we must have at least one hex digit after 'x'
 
-				while (isHexDigit(m_char) || m_char == '_') // We keep the underscores for later validation
-					addLiteralCharAndAdvance();
+				// We keep the underscores for later validation
+				size_t const startPosition = sourcePos();
+				advanceWhile([](char c) { return isHexDigit(c) || c == '_'; });
+				m_tokens[NextNext].literal.append(source(), startPosition, sourcePos() - startPosition);
 			}
 			else if (isDecimalDigit(m_char))
 				// We do not allow octal numbers
@@ -1021,10 +1045,14 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	size_t const startPosition = sourcePos();
+	advance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	if (m_kind == ScannerKind::Yul)
+		advanceWhile([](char c) { return isIdentifierPart(c) || c == '.'; });
+	else
+		advanceWhile(isIdentifierPart);
+	m_tokens[NextNext].literal.assign(source(), startPosition, sourcePos() - startPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
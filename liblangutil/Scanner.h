@@ -212,6 +212,10 @@ private:
 	///@}
 
 	bool advance() { m_char = m_source->advanceAndGet(); return !m_source->isPastEndOfInput(); }
+	/// Advances while @a _predicate holds for the current character. Reads the source directly,
+	/// which is faster than calling advance() for every character.
+	template <typename Predicate>
+	void advanceWhile(Predicate const& _predicate);
 	void rollback(size_t _amount) { m_char = m_source->rollback(_amount); }
 	/// Rolls back to the start of the current token and re-runs the scanner.
 	void rescan();
@@ -270,6 +274,8 @@ private:
 	TokenDesc m_tokens[3] = {}; // desc for the current, next and nextnext token
 
 	std::shared_ptr<CharStream> m_source;
+	/// Interned name of m_source, referenced by the locations of the tokens.
+	std::string const* m_sourceName = nullptr;
 
 	ScannerKind m_kind = ScannerKind::Solidity;
 
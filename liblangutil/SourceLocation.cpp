@@ -25,6 +25,37 @@ using namespace solidity;
 namespace solidity::langutil
 {
 
+namespace
+{
+thread_local SourceNameRepository* currentRepository = nullptr;
+}
+
+SourceNameRepository::Scope::Scope(SourceNameRepository& _repository) noexcept:
+	m_previousRepository(currentRepository)
+{
+	currentRepository = &_repository;
+}
+
+SourceNameRepository::Scope::~Scope()
+{
+	currentRepository = m_previousRepository;
+}
+
+std::string const* SourceNameRepository::intern(std::string const& _sourceName)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return &*m_names.insert(_sourceName).first;
+}
+
+SourceNameRepository& SourceNameRepository::current() noexcept
+{
+	if (currentRepository)
+		return *currentRepository;
+	// Shared by all threads, since locations created outside of a scope may be passed between them.
+	static SourceNameRepository processRepository;
+	return processRepository;
+}
+
 SourceLocation const parseSourceLocation(std::string const& _input, std::string const& _sourceName, size_t _maxIndex)
 {
 	// Expected input: "start:length:sourceindex"
@@ -43,10 +74,7 @@ SourceLocation const parseSourceLocation(std::string const& _input, std::string
 	int start = stoi(pos[Start]);
 	int end = start + stoi(pos[Length]);
 
-	// ASSUMPTION: only the name of source is used from here on, the m_source of the CharStream-Object can be empty
-	std::shared_ptr<langutil::CharStream> source = std::make_shared<langutil::CharStream>("", _sourceName);
-
-	return SourceLocation{start, end, source};
+	return SourceLocation{start, end, internSourceName(_sourceName)};
 }
 
 }
@@ -28,66 +28,102 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 
 namespace solidity::langutil
 {
 struct SourceLocationError: virtual util::Exception {};
 
+/**
+ * Stores the names of sources. Equal names are stored only once, so that locations can compare
+ * the pointers instead of the names. The repository has to outlive all locations referring to it.
+ *
+ * internSourceName() uses the repository installed by the innermost SourceNameRepository::Scope
+ * of the calling thread. CompilerStack owns a repository and installs it in each of its entry
+ * points, so the names are freed together with the stack and locations of different stacks never
+ * compare equal. Code that does not run inside a scope uses a process-wide repository.
+ */
+class SourceNameRepository
+{
+public:
+	/// Makes @a _repository the one used by internSourceName() on the current thread
+	/// during the lifetime of the scope.
+	class Scope
+	{
+	public:
+		explicit Scope(SourceNameRepository& _repository) noexcept;
+		~Scope();
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		SourceNameRepository* m_previousRepository = nullptr;
+	};
+
+	/// @returns a copy of @a _sourceName that stays valid for the lifetime of the repository.
+	std::string const* intern(std::string const& _sourceName);
+
+	/// @returns the repository used by internSourceName() on the current thread.
+	static SourceNameRepository& current() noexcept;
+
+private:
+	std::mutex m_mutex;
+	/// The elements of an unordered_set are never moved, so the pointers stay valid.
+	std::unordered_set<std::string> m_names;
+};
+
+/// @returns @a _sourceName interned in the current SourceNameRepository.
+inline std::string const* internSourceName(std::string const& _sourceName)
+{
+	return SourceNameRepository::current().intern(_sourceName);
+}
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
+ *
+ * The source is only referenced by its interned name, so that locations are cheap to copy.
+ * The source text has to be retrieved from a CharStreamProvider when it is needed.
  */
 struct SourceLocation
 {
 	bool operator==(SourceLocation const& _other) const
 	{
-		return source.get() == _other.source.get() && start == _other.start && end == _other.end;
+		return sourceName == _other.sourceName && start == _other.start && end == _other.end;
 	}
 	bool operator!=(SourceLocation const& _other) const { return !operator==(_other); }
 
 	inline bool operator<(SourceLocation const& _other) const
 	{
-		if (!source|| !_other.source)
-			return std::make_tuple(int(!!source), start, end) < std::make_tuple(int(!!_other.source), _other.start, _other.end);
+		if (!sourceName || !_other.sourceName)
+			return std::make_tuple(int(!!sourceName), start, end) < std::make_tuple(int(!!_other.sourceName), _other.start, _other.end);
 		else
-			return std::make_tuple(source->name(), start, end) < std::make_tuple(_other.source->name(), _other.start, _other.end);
+			return std::make_tuple(*sourceName, start, end) < std::make_tuple(*_other.sourceName, _other.start, _other.end);
 	}
 
 	inline bool contains(SourceLocation const& _other) const
 	{
-		if (!hasText() || !_other.hasText() || source.get() != _other.source.get())
+		if (!hasText() || !_other.hasText() || sourceName != _other.sourceName)
 			return false;
 		return start <= _other.start && _other.end <= end;
 	}
 
 	inline bool intersects(SourceLocation const& _other) const
 	{
-		if (!hasText() || !_other.hasText() || source.get() != _other.source.get())
+		if (!hasText() || !_other.hasText() || sourceName != _other.sourceName)
 			return false;
 		return _other.start < end && start < _other.end;
 	}
 
-	bool isValid() const { return source || start != -1 || end != -1; }
+	bool isValid() const { return sourceName || start != -1 || end != -1; }
 
-	bool hasText() const
-	{
-		return
-			source &&
-			0 <= start &&
-			start <= end &&
-			end <= int(source->source().length());
-	}
-
-	std::string text() const
-	{
-		assertThrow(source, SourceLocationError, "Requested text from null source.");
-		assertThrow(0 <= start, SourceLocationError, "Invalid source location.");
-		assertThrow(start <= end, SourceLocationError, "Invalid source location.");
-		assertThrow(end <= int(source->source().length()), SourceLocationError, "Invalid source location.");
-		return source->source().substr(size_t(start), size_t(end - start));
-	}
+	/// @returns true if the location refers to a (possibly empty) range of a source.
+	/// Whether the range lies within the source text can only be checked using the CharStream.
+	bool hasText() const { return sourceName && 0 <= start && start <= end; }
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
 	/// Assumes that @param _a and @param _b refer to the same source (exception: if the source of either one
@@ -96,8 +132,8 @@ struct SourceLocation
 	/// @param _b, then start resp. end of the result will be -1 as well).
 	static SourceLocation smallestCovering(SourceLocation _a, SourceLocation const& _b)
 	{
-		if (!_a.source)
-			_a.source = _b.source;
+		if (!_a.sourceName)
+			_a.sourceName = _b.sourceName;
 
 		if (_a.start < 0)
 			_a.start = _b.start;
@@ -111,7 +147,9 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<CharStream> source;
+	/// Name of the source, interned using internSourceName(), or nullptr if the location
+	/// does not refer to a source.
+	std::string const* sourceName = nullptr;
 };
 
 SourceLocation const parseSourceLocation(
@@ -126,8 +164,8 @@ inline std::ostream& operator<<(std::ostream& _out, SourceLocation const& _locat
 	if (!_location.isValid())
 		return _out << "NO_LOCATION_SPECIFIED";
 
-	if (_location.source)
-		_out << _location.source->name();
+	if (_location.sourceName)
+		_out << *_location.sourceName;
 
 	_out << "[" << _location.start << "," << _location.end << "]";
 
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceExtractor.h>
 
@@ -37,8 +38,13 @@ struct SourceLocation;
 class SourceReferenceFormatter
 {
 public:
-	SourceReferenceFormatter(std::ostream& _stream, bool _colored, bool _withErrorIds):
-		m_stream(_stream), m_colored(_colored), m_withErrorIds(_withErrorIds)
+	SourceReferenceFormatter(
+		std::ostream& _stream,
+		CharStreamProvider const& _charStreamProvider,
+		bool _colored,
+		bool _withErrorIds
+	):
+		m_stream(_stream), m_charStreamProvider(_charStreamProvider), m_colored(_colored), m_withErrorIds(_withErrorIds)
 	{}
 
 	/// Prints source location if it is given.
@@ -50,24 +56,31 @@ public:
 	static std::string formatExceptionInformation(
 		util::Exception const& _exception,
 		std::string const& _name,
+		CharStreamProvider const& _charStreamProvider,
 		bool _colored = false,
 		bool _withErrorIds = false
 	)
 	{
 		std::ostringstream errorOutput;
-		SourceReferenceFormatter formatter(errorOutput, _colored, _withErrorIds);
+		SourceReferenceFormatter formatter(errorOutput, _charStreamProvider, _colored, _withErrorIds);
 		formatter.printExceptionInformation(_exception, _name);
 		return errorOutput.str();
 	}
 
-	static std::string formatErrorInformation(Error const& _error)
+	static std::string formatErrorInformation(Error const& _error, CharStreamProvider const& _charStreamProvider)
 	{
 		return formatExceptionInformation(
 			_error,
-			(_error.type() == Error::Type::Warning) ? "Warning" : "Error"
+			(_error.type() == Error::Type::Warning) ? "Warning" : "Error",
+			_charStreamProvider
 		);
 	}
 
+	static std::string formatErrorInformation(Error const& _error, CharStream const& _charStream)
+	{
+		return formatErrorInformation(_error, SingletonCharStreamProvider(_charStream));
+	}
+
 private:
 	util::AnsiColorized normalColored() const;
 	util::AnsiColorized frameColored() const;
@@ -79,6 +92,7 @@ private:
 
 private:
 	std::ostream& m_stream;
+	CharStreamProvider const& m_charStreamProvider;
 	bool m_colored;
 	bool m_withErrorIds;
 };
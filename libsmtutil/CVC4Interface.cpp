@@ -121,6 +121,11 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_solver.interrupt();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
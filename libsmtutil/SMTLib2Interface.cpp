@@ -20,7 +20,6 @@
 
 #include <libsolutil/Keccak256.h>
 
-#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <array>
@@ -52,7 +51,8 @@ SMTLib2Interface::SMTLib2Interface(
 void SMTLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
-	m_accumulatedOutput.emplace_back();
+	m_accumulatedOutputHash = {};
+	m_frames.clear();
 	m_variables.clear();
 	m_userSorts.clear();
 	write("(set-option :produce-models true)");
@@ -63,13 +63,17 @@ void SMTLib2Interface::reset()
 
 void SMTLib2Interface::push()
 {
-	m_accumulatedOutput.emplace_back();
+	m_frames.emplace_back(m_accumulatedOutput.size(), m_accumulatedOutputHash);
+	// The commands of different frames are separated by an empty line.
+	append("\n");
 }
 
 void SMTLib2Interface::pop()
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.pop_back();
+	smtAssert(!m_frames.empty(), "");
+	m_accumulatedOutput.resize(m_frames.back().first);
+	m_accumulatedOutputHash = m_frames.back().second;
+	m_frames.pop_back();
 }
 
 void SMTLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
@@ -114,10 +118,7 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = querySolver(checkSatAndGetValuesCommand(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -137,21 +138,30 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 }
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
+{
+	string sexpr;
+	toSExpr(_expr, sexpr);
+	return sexpr;
+}
+
+void SMTLib2Interface::toSExpr(Expression const& _expr, string& _sexpr)
 {
 	if (_expr.arguments.empty())
-		return _expr.name;
+	{
+		_sexpr += _expr.name;
+		return;
+	}
 
-	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
 		size_t size = std::stoul(_expr.arguments[1].name);
 		auto arg = toSExpr(_expr.arguments.front());
 		auto int2bv = "(_ int2bv " + to_string(size) + ")";
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
+		_sexpr += string("(ite ") +
 			"(>= " + arg + " 0) " +
 			"(" + int2bv + " " + arg + ") " +
-			"(bvneg (" + int2bv + " (- " + arg + ")))";
+			"(bvneg (" + int2bv + " (- " + arg + "))))";
 	}
 	else if (_expr.name == "bv2int")
 	{
@@ -162,7 +172,10 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto nat = "(bv2nat " + arg + ")";
 
 		if (!intSort->isSigned)
-			return nat;
+		{
+			_sexpr += nat;
+			return;
+		}
 
 		auto bvSort = dynamic_pointer_cast<BitVectorSort>(_expr.arguments.front().sort);
 		smtAssert(bvSort, "");
@@ -170,10 +183,10 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto pos = to_string(bvSort->size - 1);
 
 		// Some solvers treat all BVs as unsigned, so we need to manually apply 2's complement if needed.
-		sexpr += string("ite ") +
+		_sexpr += string("(ite ") +
 			"(= ((_ extract " + pos + " " + pos + ")" + arg + ") #b0) " +
 			nat + " " +
-			"(- (bvneg " + arg + "))";
+			"(- (bvneg " + arg + ")))";
 	}
 	else if (_expr.name == "const_array")
 	{
@@ -182,8 +195,9 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		smtAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		smtAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		_sexpr += "((as const " + toSmtLibSort(*arraySort) + ") ";
+		toSExpr(_expr.arguments.at(1), _sexpr);
+		_sexpr += ")";
 	}
 	else if (_expr.name == "tuple_get")
 	{
@@ -191,24 +205,30 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.arguments.at(0).sort);
 		size_t index = std::stoul(_expr.arguments.at(1).name);
 		smtAssert(index < tupleSort->members.size(), "");
-		sexpr += "|" + tupleSort->members.at(index) + "| " + toSExpr(_expr.arguments.at(0));
-	}
-	else if (_expr.name == "tuple_constructor")
-	{
-		auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
-		smtAssert(tupleSort, "");
-		sexpr += "|" + tupleSort->name + "|";
-		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		_sexpr += "(|" + tupleSort->members.at(index) + "| ";
+		toSExpr(_expr.arguments.at(0), _sexpr);
+		_sexpr += ")";
 	}
 	else
 	{
-		sexpr += _expr.name;
+		// The arguments are appended to the same string instead of being returned and
+		// concatenated, which would copy deeply nested expressions once per level.
+		_sexpr += "(";
+		if (_expr.name == "tuple_constructor")
+		{
+			auto tupleSort = dynamic_pointer_cast<TupleSort>(_expr.sort);
+			smtAssert(tupleSort, "");
+			_sexpr += "|" + tupleSort->name + "|";
+		}
+		else
+			_sexpr += _expr.name;
 		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		{
+			_sexpr += " ";
+			toSExpr(arg, _sexpr);
+		}
+		_sexpr += ")";
 	}
-	sexpr += ")";
-	return sexpr;
 }
 
 string SMTLib2Interface::toSmtLibSort(Sort const& _sort)
@@ -260,8 +280,15 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 
 void SMTLib2Interface::write(string _data)
 {
-	smtAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	_data += "\n";
+	append(_data);
+}
+
+void SMTLib2Interface::append(string const& _text)
+{
+	if (!m_queryResponses.empty())
+		m_accumulatedOutputHash.absorb(_text);
+	m_accumulatedOutput += _text;
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -305,17 +332,23 @@ vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, stri
 	return values;
 }
 
-string SMTLib2Interface::querySolver(string const& _input)
+string SMTLib2Interface::querySolver(string const& _command)
 {
-	h256 inputHash = keccak256(_input);
-	if (m_queryResponses.count(inputHash))
-		return m_queryResponses.at(inputHash);
+	if (!m_queryResponses.empty())
+	{
+		IncrementalKeccak256 inputHash = m_accumulatedOutputHash;
+		inputHash.absorb(_command);
+		auto response = m_queryResponses.find(inputHash.digest());
+		if (response != m_queryResponses.end())
+			return response->second;
+	}
+	string input = m_accumulatedOutput + _command;
 	if (m_smtCallback)
 	{
-		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
+		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), input);
 		if (result.success)
 			return result.responseOrErrorMessage;
 	}
-	m_unhandledQueries.push_back(_input);
+	m_unhandledQueries.push_back(move(input));
 	return "unknown\n";
 }
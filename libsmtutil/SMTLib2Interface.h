@@ -24,6 +24,7 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/Keccak256.h>
 
 #include <boost/noncopyable.hpp>
 #include <cstdio>
@@ -35,6 +36,16 @@
 namespace solidity::smtutil
 {
 
+/**
+ * Solver interface that creates SMT-LIB2 queries and passes them to the SMT callback,
+ * or answers them with the responses given to the constructor.
+ * Every query is self-contained: it consists of all commands issued so far, followed
+ * by the command to check satisfiability. The commands are kept as one text, so
+ * push() and pop() only remember and restore its length, and creating a query does
+ * not depend on the number of frames. If there are responses, the hash of the commands
+ * is kept up to date the same way, so looking up the response of a query only has to hash
+ * the command that checks satisfiability.
+ */
 class SMTLib2Interface: public SolverInterface, public boost::noncopyable
 {
 public:
@@ -64,17 +75,26 @@ public:
 	std::map<std::string, SortPointer> variables() { return m_variables; }
 
 private:
+	/// Appends the s-expression of @a _expr to @a _sexpr.
+	void toSExpr(Expression const& _expr, std::string& _sexpr);
+
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
 	void write(std::string _data);
+	void append(std::string const& _text);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
+	/// Communicates with the solver via the callback, sending the accumulated output
+	/// followed by @a _command. Throws SMTSolverError on error.
+	std::string querySolver(std::string const& _command);
 
-	std::vector<std::string> m_accumulatedOutput;
+	std::string m_accumulatedOutput;
+	/// Hash of m_accumulatedOutput, only kept if there are query responses.
+	util::IncrementalKeccak256 m_accumulatedOutputHash;
+	/// Length and hash of m_accumulatedOutput at each push().
+	std::vector<std::pair<size_t, util::IncrementalKeccak256>> m_frames;
 	std::map<std::string, SortPointer> m_variables;
 	std::set<std::string> m_userSorts;
 
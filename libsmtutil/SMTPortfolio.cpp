@@ -26,6 +26,10 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <libsolutil/Parallel.h>
+
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,9 +40,11 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers)
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
 #ifdef HAVE_Z3
@@ -55,6 +61,7 @@ void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
 }
 
 void SMTPortfolio::push()
@@ -74,6 +81,7 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
@@ -111,9 +119,16 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers race, the first solver to answer the query decides the result and
+ * conflicting answers are not detected. The answers of the solvers that did not finish
+ * before are ignored. If no solver answers, the result is decided as in 3).
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	if (m_raceSolvers && m_solvers.size() > 1)
+		return race(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
 	for (auto const& s: m_solvers)
@@ -140,6 +155,56 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	// Each solver has its own context, so they can be queried concurrently.
+	// The mutex guards everything below except for the solvers themselves.
+	mutex resultMutex;
+	vector<bool> running(m_solvers.size(), false);
+	optional<pair<CheckResult, vector<string>>> answer;
+	CheckResult nonAnswer = CheckResult::ERROR;
+	util::parallelFor(m_solvers.size(), static_cast<unsigned>(m_solvers.size()), [&](size_t _index) {
+		{
+			lock_guard<mutex> lock(resultMutex);
+			// Only happens if the solvers run one after the other.
+			if (answer)
+				return;
+			running[_index] = true;
+		}
+		CheckResult result;
+		vector<string> values;
+		try
+		{
+			tie(result, values) = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			lock_guard<mutex> lock(resultMutex);
+			running[_index] = false;
+			throw;
+		}
+
+		lock_guard<mutex> lock(resultMutex);
+		running[_index] = false;
+		if (answer)
+			return;
+		if (solverAnswered(result))
+		{
+			answer = make_pair(result, move(values));
+			// An interrupt that arrives before a solver starts checking is lost, in which
+			// case we still wait for that solver to finish.
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (running[i])
+					m_solvers[i]->interrupt();
+		}
+		else if (result == CheckResult::UNKNOWN)
+			nonAnswer = result;
+	});
+	if (answer)
+		return move(*answer);
+	return make_pair(nonAnswer, vector<string>{});
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
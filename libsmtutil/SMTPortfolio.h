@@ -34,7 +34,8 @@ namespace solidity::smtutil
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * to SMT queries, unless the solvers race each other: then they all run
+ * concurrently and the first one to answer a query decides it.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -43,7 +44,8 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false
 	);
 
 	void reset() override;
@@ -59,11 +61,20 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
+
+	/// @returns the variables declared since the last reset, in order of declaration.
+	std::vector<std::pair<std::string, SortPointer>> const& declarations() const { return m_declarations; }
 private:
+	/// Runs all solvers concurrently, interrupts the others once one of them answers and
+	/// returns that answer.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_raceSolvers = false;
 
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
 	std::vector<Expression> m_assertions;
 };
 
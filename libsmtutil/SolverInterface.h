@@ -399,6 +399,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a check() running on another thread to stop as soon as possible, in which case it
+	/// returns UNKNOWN. Does nothing if the solver cannot be interrupted.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
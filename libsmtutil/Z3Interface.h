@@ -41,6 +41,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
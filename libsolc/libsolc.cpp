@@ -30,6 +30,7 @@
 
 #include <cstdlib>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "license.h"
@@ -114,6 +115,23 @@ string compile(string _input, CStyleReadFileCallback _readCallback, void* _readC
 	return compiler.compile(move(_input));
 }
 
+/// Compiler used by solidity_compile_cached(), which keeps its cache until solidity_reset().
+static unique_ptr<StandardCompiler> cachingCompiler;
+
+string compileCached(string const& _input, CStyleReadFileCallback _readCallback, void* _readContext)
+{
+	if (!cachingCompiler)
+	{
+		cachingCompiler = make_unique<StandardCompiler>();
+		cachingCompiler->enableArtifactCache();
+	}
+	cachingCompiler->setReadCallback(wrapReadCallback(_readCallback, _readContext));
+	string output = cachingCompiler->compile(_input);
+	// The callback and its context are only valid during this call.
+	cachingCompiler->setReadCallback({});
+	return output;
+}
+
 }
 
 extern "C"
@@ -134,6 +152,11 @@ extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCa
 	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
 }
 
+extern char* solidity_compile_cached(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
+{
+	return solidityAllocations.emplace_back(compileCached(_input, _readCallback, _readContext)).data();
+}
+
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
@@ -157,6 +180,7 @@ extern void solidity_reset() noexcept
 	// This is called right before each compilation, but not at the end, so additional memory
 	// can be freed here.
 	yul::YulStringRepository::reset();
+	cachingCompiler.reset();
 	solidityAllocations.clear();
 }
 }
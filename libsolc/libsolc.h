@@ -90,6 +90,16 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
+/// Like solidity_compile(), but keeps the contents of the sources and the outputs between calls.
+/// Sources that were part of the previous call can be given by their "keccak256" hash alone and
+/// a call that repeats one of the 16 most recently used inputs returns its earlier output without recompiling,
+/// unless files read through the callback have changed in the meantime.
+///
+/// The cache is dropped by solidity_reset().
+///
+/// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
+char* solidity_compile_cached(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
+
 /// Frees up any allocated memory.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
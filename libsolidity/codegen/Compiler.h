@@ -36,8 +36,14 @@ namespace solidity::frontend {
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		unsigned _parallelism = 1
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
+		m_parallelism(_parallelism),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
@@ -67,6 +73,8 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	/// Maximum number of threads used by the optimiser.
+	unsigned const m_parallelism;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
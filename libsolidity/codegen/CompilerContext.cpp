@@ -43,6 +43,7 @@
 
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Keccak256.h>
 
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/Scanner.h>
@@ -50,6 +51,8 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <list>
+#include <mutex>
 #include <utility>
 #include <numeric>
 
@@ -64,6 +67,162 @@ using namespace solidity::evmasm;
 using namespace solidity::frontend;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// Yul code after parsing, analysis and optimisation.
+struct AnalysedYulCode
+{
+	/// The code as it is reported in the generated sources.
+	string code;
+	shared_ptr<yul::Block const> ast;
+	yul::AsmAnalysisInfo analysisInfo;
+};
+
+/// Process-wide cache of the Yul utility code of contracts, since most contracts request the same
+/// ABI and utility functions. Entries are shared between threads and never modified.
+/// If the cache is full, the least recently used entry is removed.
+/// The ASTs contain YulStrings, so the cache is cleared when the YulString repository is reset.
+/// Their source locations refer to the cache's own source name repository, since the entries
+/// outlive the compiler stack that created them.
+class YulUtilityCodeCache
+{
+public:
+	static YulUtilityCodeCache& instance()
+	{
+		static YulUtilityCodeCache cache;
+		static yul::YulStringRepository::ResetCallback callback{[]{ YulUtilityCodeCache::instance().clear(); }};
+		return cache;
+	}
+
+	SourceNameRepository& sourceNames() { return m_sourceNames; }
+
+	shared_ptr<AnalysedYulCode const> find(h256 const& _key)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return nullptr;
+		m_keysByUse.splice(m_keysByUse.begin(), m_keysByUse, it->second.position);
+		return it->second.code;
+	}
+
+	void insert(h256 const& _key, shared_ptr<AnalysedYulCode const> _code)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		// Another thread may have added the same code in the meantime.
+		if (m_entries.count(_key))
+			return;
+		if (m_entries.size() >= maxEntries)
+		{
+			m_entries.erase(m_keysByUse.back());
+			m_keysByUse.pop_back();
+		}
+		m_keysByUse.push_front(_key);
+		m_entries.emplace(_key, Entry{move(_code), m_keysByUse.begin()});
+	}
+
+	void clear()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_entries.clear();
+		m_keysByUse.clear();
+	}
+
+private:
+	struct Entry
+	{
+		shared_ptr<AnalysedYulCode const> code;
+		/// Position of the key in m_keysByUse.
+		list<h256>::iterator position;
+	};
+
+	static size_t constexpr maxEntries = 256;
+
+	SourceNameRepository m_sourceNames;
+	mutex m_mutex;
+	map<h256, Entry> m_entries;
+	/// Keys of m_entries, the most recently used first.
+	list<h256> m_keysByUse;
+};
+
+/// Parses and analyses the Yul code @a _code that @a _context generated and optimises it
+/// if @a _optimiserSettings request it.
+/// @param _locationOverride if set, the source location of all nodes of the AST.
+/// @param _resolver resolves the identifiers that are not declared in the code.
+/// @param _reparse if set, the optimised code is printed and parsed again, so that its source
+/// locations refer to the printed code, which is returned as the code.
+shared_ptr<AnalysedYulCode> parseAnalyseAndOptimise(
+	CompilerContext& _context,
+	string _code,
+	string const& _sourceName,
+	optional<SourceLocation> _locationOverride,
+	yul::ExternalIdentifierAccess::Resolver const& _resolver,
+	set<yul::YulString> const& _externallyUsedIdentifiers,
+	OptimiserSettings const& _optimiserSettings,
+	bool _reparse
+)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(_context.evmVersion());
+	auto result = make_shared<AnalysedYulCode>();
+
+	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_code, _sourceName));
+	shared_ptr<yul::Block> ast = yul::Parser(errorReporter, dialect, move(_locationOverride)).parse(scanner, false);
+#ifdef SOL_OUTPUT_ASM
+	cout << yul::AsmPrinter(&dialect)(*ast) << endl;
+#endif
+	bool analyzerResult = false;
+	if (ast)
+		analyzerResult = yul::AsmAnalyzer(result->analysisInfo, errorReporter, dialect, _resolver).analyze(*ast);
+	if (!ast || !errorReporter.errors().empty() || !analyzerResult)
+	{
+		string message =
+			"Error parsing/analyzing Yul code generated by the code generator:\n"
+			"------------------ Input: -----------------\n" +
+			_code + "\n"
+			"------------------ Errors: ----------------\n";
+		for (auto const& error: errorReporter.errors())
+			message += SourceReferenceFormatter::formatErrorInformation(*error, *scanner->charStream());
+		message += "-------------------------------------------\n";
+		solAssert(false, message);
+	}
+
+	if (_optimiserSettings.runYulOptimiser)
+	{
+		yul::Object obj;
+		obj.code = ast;
+		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(move(result->analysisInfo));
+		_context.optimizeYul(obj, dialect, _optimiserSettings, _externallyUsedIdentifiers);
+
+		if (_reparse)
+		{
+			result->code = yul::AsmPrinter(dialect)(*obj.code);
+			scanner = make_shared<langutil::Scanner>(langutil::CharStream(result->code, _sourceName));
+			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
+			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
+		}
+		else
+			result->code = move(_code);
+		result->analysisInfo = move(*obj.analysisInfo);
+		ast = move(obj.code);
+
+#ifdef SOL_OUTPUT_ASM
+		cout << "After optimizer:" << endl;
+		cout << yul::AsmPrinter(&dialect)(*ast) << endl;
+#endif
+	}
+	else
+		result->code = move(_code);
+
+	solAssert(errorReporter.errors().empty(), "Failed to analyze Yul code generated by the code generator.");
+	result->ast = move(ast);
+	return result;
+}
+
+}
+
 void CompilerContext::addStateVariable(
 	VariableDeclaration const& _declaration,
 	u256 const& _storageOffset,
@@ -200,15 +359,59 @@ void CompilerContext::appendYulUtilityFunctions(OptimiserSettings const& _optimi
 	string code = m_yulFunctionCollector.requestedFunctions();
 	if (!code.empty())
 	{
-		appendInlineAssembly(
-			yul::reindent("{\n" + move(code) + "\n}"),
-			{},
-			m_externallyUsedYulFunctions,
+		code = yul::reindent("{\n" + move(code) + "\n}");
+		bool const isCreation = runtimeContext() != nullptr;
+
+		// Everything the parsed and optimised code depends on.
+		string key = m_evmVersion.name() + (isCreation ? " creation\n" : " runtime\n");
+		for (bool flag: {
+			_optimiserSettings.runYulOptimiser,
+			_optimiserSettings.optimizeStackAllocation
+		})
+			key += flag ? "1" : "0";
+		key += " " + _optimiserSettings.yulOptimiserSteps;
+		key += " " + to_string(_optimiserSettings.expectedExecutionsPerDeployment) + "\n";
+		for (string const& function: m_externallyUsedYulFunctions)
+			key += function + " ";
+		key += "\n" + code;
+		h256 hash = keccak256(key);
+
+		shared_ptr<AnalysedYulCode const> utilityCode = YulUtilityCodeCache::instance().find(hash);
+		if (!utilityCode)
+		{
+			set<yul::YulString> externallyUsedIdentifiers;
+			for (auto const& function: m_externallyUsedYulFunctions)
+				externallyUsedIdentifiers.insert(yul::YulString(function));
+			SourceNameRepository::Scope sourceNameScope(YulUtilityCodeCache::instance().sourceNames());
+			utilityCode = parseAnalyseAndOptimise(
+				*this,
+				move(code),
+				yulUtilityFileName(),
+				nullopt,
+				{},
+				externallyUsedIdentifiers,
+				_optimiserSettings,
+				true
+			);
+			YulUtilityCodeCache::instance().insert(hash, utilityCode);
+		}
+
+		m_generatedYulUtilityCode = utilityCode->code;
+		solAssert(!m_generatedYulUtilityCode.empty(), "");
+
+		// The code transform takes the analysis info by non-const reference, so every contract
+		// gets its own copy. The scopes it refers to are shared.
+		yul::AsmAnalysisInfo analysisInfo = utilityCode->analysisInfo;
+		yul::CodeGenerator::assemble(
+			*utilityCode->ast,
+			analysisInfo,
+			*m_asm,
+			m_evmVersion,
+			yul::ExternalIdentifierAccess{},
 			true,
-			_optimiserSettings,
-			yulUtilityFileName()
+			_optimiserSettings.optimizeStackAllocation
 		);
-		solAssert(!m_generatedYulUtilityCode.empty(), "");
+		updateSourceLocation();
 	}
 }
 
@@ -387,9 +590,8 @@ void CompilerContext::appendInlineAssembly(
 	string const& _assembly,
 	vector<string> const& _localVariables,
 	set<string> const& _externallyUsedFunctions,
-	bool _system,
 	OptimiserSettings const& _optimiserSettings,
-	string _sourceName
+	string const& _sourceName
 )
 {
 	unsigned startStackHeight = stackHeight();
@@ -438,94 +640,25 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, _sourceName));
-	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion);
-	optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
-	shared_ptr<yul::Block> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
-		.parse(scanner, false);
-#ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-
-	auto reportError = [&](string const& _context)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n" +
-			_context + "\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatErrorInformation(*error);
-		message += "-------------------------------------------\n";
-
-		solAssert(false, message);
-	};
-
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			dialect,
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-		reportError("Invalid assembly generated by code generator.");
-
 	// Several optimizer steps cannot handle externally supplied stack variables,
 	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
-	{
-		yul::Object obj;
-		obj.code = parserResult;
-		obj.analysisInfo = make_shared<yul::AsmAnalysisInfo>(analysisInfo);
-
-		optimizeYul(obj, dialect, _optimiserSettings, externallyUsedIdentifiers);
-
-		if (_system)
-		{
-			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter(dialect)(*obj.code);
-			string code = yul::AsmPrinter{dialect}(*obj.code);
-			scanner = make_shared<langutil::Scanner>(langutil::CharStream(m_generatedYulUtilityCode, _sourceName));
-			obj.code = yul::Parser(errorReporter, dialect).parse(scanner, false);
-			*obj.analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(dialect, obj);
-		}
-
-		analysisInfo = std::move(*obj.analysisInfo);
-		parserResult = std::move(obj.code);
-
-#ifdef SOL_OUTPUT_ASM
-		cout << "After optimizer:" << endl;
-		cout << yul::AsmPrinter(&dialect)(*parserResult) << endl;
-#endif
-	}
-	else if (_system)
-	{
-		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
-
-	if (!errorReporter.errors().empty())
-		reportError("Failed to analyze inline assembly block.");
-
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	shared_ptr<AnalysedYulCode> code = parseAnalyseAndOptimise(
+		*this,
+		_assembly,
+		_sourceName,
+		m_asm->currentSourceLocation(),
+		identifierAccess.resolve,
+		externallyUsedIdentifiers,
+		_localVariables.empty() ? _optimiserSettings : OptimiserSettings::none(),
+		false
+	);
 	yul::CodeGenerator::assemble(
-		*parserResult,
-		analysisInfo,
+		*code->ast,
+		code->analysisInfo,
 		*m_asm,
 		m_evmVersion,
 		identifierAccess,
-		_system,
+		false,
 		_optimiserSettings.optimizeStackAllocation
 	);
 
@@ -567,10 +700,13 @@ void CompilerContext::updateSourceLocation()
 	m_asm->setSourceLocation(m_visitedNodes.empty() ? SourceLocation() : m_visitedNodes.top()->location());
 }
 
-evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(OptimiserSettings const& _settings)
+evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(
+	OptimiserSettings const& _settings,
+	unsigned _parallelism
+)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false, false, false, false, false, false, m_evmVersion, 0, 1};
 	asmSettings.isCreation = true;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -579,6 +715,7 @@ evmasm::Assembly::OptimiserSettings CompilerContext::translateOptimiserSettings(
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
 	asmSettings.evmVersion = m_evmVersion;
+	asmSettings.parallelism = _parallelism;
 	return asmSettings;
 }
 
@@ -254,17 +254,15 @@ public:
 	/// @param _assembly the assembly text, should be a block.
 	/// @param _localVariables assigns stack positions to variables with the last one being the stack top
 	/// @param _externallyUsedFunctions a set of function names that are not to be renamed or removed.
-	/// @param _system if true, this is a "system-level" assembly where all functions use named labels
-	///                and the code is marked to be exported as "compiler-generated assembly utility file".
-	/// @param _optimiserSettings settings for the Yul optimiser, which is run in this function already.
+	/// @param _optimiserSettings settings for the Yul optimiser, which is run in this function already
+	///                           unless there are local variables.
 	/// @param _sourceName the name of the assembly file to be used for source locations
 	void appendInlineAssembly(
 		std::string const& _assembly,
 		std::vector<std::string> const& _localVariables = std::vector<std::string>(),
 		std::set<std::string> const& _externallyUsedFunctions = std::set<std::string>(),
-		bool _system = false,
 		OptimiserSettings const& _optimiserSettings = OptimiserSettings::none(),
-		std::string _sourceName = "--CODEGEN--"
+		std::string const& _sourceName = "--CODEGEN--"
 	);
 
 	/// If m_revertStrings is debug, @returns inline assembly code that
@@ -277,8 +275,11 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(translateOptimiserSettings(_settings)); }
+	/// Run optimisation step, optimising independent sub-assemblies on up to @a _parallelism threads.
+	void optimise(OptimiserSettings const& _settings, unsigned _parallelism = 1)
+	{
+		m_asm->optimise(translateOptimiserSettings(_settings, _parallelism));
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -309,7 +310,7 @@ private:
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
-	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings);
+	evmasm::Assembly::OptimiserSettings translateOptimiserSettings(OptimiserSettings const& _settings, unsigned _parallelism);
 
 	/**
 	 * Helper class that manages function labels and ensures that referenced functions are
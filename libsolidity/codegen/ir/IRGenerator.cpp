@@ -30,8 +30,11 @@
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 
+#include <libyul/AST.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
@@ -48,35 +51,68 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(
+namespace
+{
+
+string const warning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+tuple<string, shared_ptr<yul::Object>, shared_ptr<yul::Block>> IRGenerator::run(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	function<shared_ptr<yul::Object>(ContractDefinition const&)> const& _subObject
 )
 {
-	string const ir = yul::reindent(generate(_contract, _otherYulSources));
+	GeneratedCode code = generate(_contract, _otherYulSources);
+	string const ir = yul::reindent(code.withSubObjects);
+	string const ownIR = yul::reindent(code.withoutSubObjects);
+
+	// Only the code of this contract is parsed. The objects of the created contracts are
+	// optimized already and shared with all other contracts that create them.
+	map<yul::YulString, vector<shared_ptr<yul::Object>>> subObjects;
+	set<yul::Object const*> finishedObjects;
+	auto addSubObject = [&](ContractDefinition const* _subObjectContract, string const& _parentName)
+	{
+		shared_ptr<yul::Object> object = _subObject(*_subObjectContract);
+		finishedObjects.insert(object.get());
+		subObjects[yul::YulString{_parentName}].emplace_back(move(object));
+	};
+	for (ContractDefinition const* subObject: code.creationSubObjects)
+		addSubObject(subObject, IRNames::creationObject(_contract));
+	for (ContractDefinition const* subObject: code.runtimeSubObjects)
+		addSubObject(subObject, IRNames::runtimeObject(_contract));
 
 	yul::AssemblyStack asmStack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	if (!asmStack.parseAndAnalyze("", ir))
+	asmStack.setParallelism(m_parallelism);
+	if (!asmStack.parseAndAnalyze("", ownIR, subObjects, move(finishedObjects)))
 	{
 		string errorMessage;
 		for (auto const& error: asmStack.errors())
-			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
-		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error, asmStack);
+		solAssert(false, ownIR + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	shared_ptr<yul::Block> unoptimizedCode;
+	if (m_optimiserSettings.runYulOptimiser)
+		unoptimizedCode = make_shared<yul::Block>(std::get<yul::Block>(yul::ASTCopier{}(*asmStack.parserResult()->code)));
 	asmStack.optimize();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {warning + ir, asmStack.parserResult(), move(unoptimizedCode)};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::printOptimized(yul::Object const& _object, langutil::EVMVersion _evmVersion)
+{
+	// This is what AssemblyStack::print() returns for the object.
+	return warning + _object.toString(&yul::EVMDialect::strictAssemblyForEVMObjects(_evmVersion)) + "\n";
 }
 
-string IRGenerator::generate(
+IRGenerator::GeneratedCode IRGenerator::generate(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
@@ -89,6 +125,7 @@ string IRGenerator::generate(
 		return subObjectsSources;
 	};
 
+	GeneratedCode code;
 	Whiskers t(R"(
 		object "<CreationObject>" {
 			code {
@@ -145,7 +182,7 @@ string IRGenerator::generate(
 	generateQueuedFunctions();
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions();
 	t("functions", m_context.functionCollector().requestedFunctions());
-	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	code.creationSubObjects = m_context.subObjectsCreated();
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesAssembly = m_context.inlineAssemblySeen();
@@ -165,12 +202,19 @@ string IRGenerator::generate(
 	generateQueuedFunctions();
 	generateInternalDispatchFunctions();
 	t("runtimeFunctions", m_context.functionCollector().requestedFunctions());
-	t("runtimeSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	code.runtimeSubObjects = m_context.subObjectsCreated();
 
 	// This has to be called only after all other code generation for the runtime object is complete.
 	bool runtimeInvolvesAssembly = m_context.inlineAssemblySeen();
 	t("memoryInitRuntime", memoryInit(!runtimeInvolvesAssembly));
-	return t.render();
+
+	Whiskers withoutSubObjects = t;
+	code.withoutSubObjects = withoutSubObjects("subObjects", "")("runtimeSubObjects", "").render();
+	code.withSubObjects = t
+		("subObjects", subObjectSources(code.creationSubObjects))
+		("runtimeSubObjects", subObjectSources(code.runtimeSubObjects))
+		.render();
+	return code;
 }
 
 string IRGenerator::generate(Block const& _block)
@@ -28,7 +28,18 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <tuple>
+
+namespace solidity::yul
+{
+struct Block;
+struct Object;
+}
 
 namespace solidity::frontend
 {
@@ -41,23 +52,45 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		unsigned _parallelism = 1
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_parallelism(_parallelism),
 		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates the IR code and returns it in unoptimized form as text, in optimized form
+	/// (or just analyzed, depending on the optimizer settings) as an object in the
+	/// strict assembly dialect that can be assembled directly, and, if the optimizer is
+	/// enabled, the code of that object (without its sub-objects) before the optimization.
+	/// The contracts created by @a _contract are embedded as sub-objects: their unoptimized
+	/// code from @a _otherYulSources into the text and the objects returned by @a _subObject
+	/// into the object. These have to be optimized as sub-objects already. They are shared,
+	/// not copied, and are neither analyzed nor optimized again.
+	std::tuple<std::string, std::shared_ptr<yul::Object>, std::shared_ptr<yul::Block>> run(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		std::function<std::shared_ptr<yul::Object>(ContractDefinition const&)> const& _subObject
 	);
 
+	/// @returns the optimized IR code @a _object returned by run() as text.
+	static std::string printOptimized(yul::Object const& _object, langutil::EVMVersion _evmVersion);
+
 private:
-	std::string generate(
+	/// IR code of a contract, with and without the code of the contracts it creates.
+	struct GeneratedCode
+	{
+		std::string withSubObjects;
+		std::string withoutSubObjects;
+		/// Contracts created by the creation and by the runtime code, respectively.
+		std::set<ContractDefinition const*, ASTNode::CompareByID> creationSubObjects;
+		std::set<ContractDefinition const*, ASTNode::CompareByID> runtimeSubObjects;
+	};
+
+	GeneratedCode generate(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
@@ -114,6 +147,8 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Maximum number of threads used to optimize the generated code.
+	unsigned const m_parallelism;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
@@ -21,7 +21,7 @@
 #include <libsolidity/formal/SymbolicState.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
-#include <libsmtutil/SMTPortfolio.h>
+#include <libsolutil/Parallel.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
@@ -36,13 +36,25 @@ using namespace solidity::frontend;
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
+	CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	smtutil::SMTSolverChoice _enabledSolvers,
-	ModelCheckerSettings const& _settings
+	ModelCheckerSettings const& _settings,
+	unsigned _parallelism
 ):
-	SMTEncoder(_context),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
+	SMTEncoder(_context, _charStreamProvider),
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_enabledSolvers,
+		_settings.timeout,
+		_settings.raceSolvers
+	)),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_enabledSolvers(_enabledSolvers),
+	m_parallelism(_parallelism),
 	m_outerErrorReporter(_errorReporter),
 	m_settings(_settings)
 {
@@ -80,7 +92,7 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver.
-	if (!m_interface->unhandledQueries().empty() && m_interface->solvers() == 1)
+	if (!unhandledQueries().empty() && m_interface->solvers() == 1)
 	{
 		if (!m_noSolverWarning)
 		{
@@ -101,6 +113,14 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	m_errorReporter.clear();
 }
 
+vector<string> BMC::unhandledQueries()
+{
+	vector<string> queries = m_interface->unhandledQueries();
+	for (auto const& solver: m_targetSolvers)
+		queries += solver->unhandledQueries();
+	return queries;
+}
+
 bool BMC::shouldInlineFunctionCall(FunctionCall const& _funCall, ContractDefinition const* _contract)
 {
 	auto [funDef, contextContract] = functionCallToDefinition(_funCall, _contract);
@@ -657,7 +677,7 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 		if (uf->annotation().type->isValueType())
 		{
 			expressionsToEvaluate.emplace_back(expr(*uf));
-			expressionNames.push_back(uf->location().text());
+			expressionNames.push_back(m_charStreamProvider.text(uf->location()));
 		}
 
 	return {expressionsToEvaluate, expressionNames};
@@ -669,6 +689,7 @@ void BMC::checkVerificationTargets()
 {
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	checkConditions();
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -876,9 +897,6 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -888,9 +906,80 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
-	smtutil::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+
+	m_conditionChecks.emplace_back(ConditionCheck{
+		move(_condition),
+		_callStack,
+		move(expressionsToEvaluate),
+		move(expressionNames),
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		_description
+	});
+}
+
+void BMC::checkConditions()
+{
+	// Solvers that are not linked into this binary are queried one after the other
+	// through the callback anyway.
+	if (m_parallelism > 1 && m_conditionChecks.size() > 1 && m_interface->solvers() > 1)
+	{
+		vector<SolverAnswer> answers = checkConditionsConcurrently();
+		for (size_t i = 0; i < m_conditionChecks.size(); ++i)
+			reportCondition(m_conditionChecks[i], answers[i]);
+	}
+	else
+		for (ConditionCheck const& check: m_conditionChecks)
+		{
+			m_interface->push();
+			m_interface->addAssertion(check.condition);
+			reportCondition(check, querySolver(*m_interface, check.expressionsToEvaluate));
+			m_interface->pop();
+		}
+
+	m_conditionChecks.clear();
+}
+
+vector<BMC::SolverAnswer> BMC::checkConditionsConcurrently()
+{
+	// Every thread uses its own solver for a fixed subset of the queries, so that the
+	// answers do not depend on the scheduling of the threads.
+	size_t threads = min<size_t>(m_parallelism, m_conditionChecks.size());
+	while (m_targetSolvers.size() < threads)
+		m_targetSolvers.emplace_back(make_unique<smtutil::SMTPortfolio>(
+			m_smtlib2Responses,
+			[this](string const& _kind, string const& _data) {
+				lock_guard<mutex> lock(m_smtCallbackMutex);
+				return m_smtCallback(_kind, _data);
+			},
+			m_enabledSolvers,
+			m_settings.timeout,
+			m_settings.raceSolvers
+		));
+
+	auto const& declarations = m_interface->declarations();
+	vector<SolverAnswer> answers(m_conditionChecks.size());
+	util::parallelFor(threads, static_cast<unsigned>(threads), [&](size_t _thread) {
+		smtutil::SMTPortfolio& solver = *m_targetSolvers[_thread];
+		for (size_t i = solver.declarations().size(); i < declarations.size(); ++i)
+			solver.declareVariable(declarations[i].first, declarations[i].second);
+
+		for (size_t i = _thread; i < m_conditionChecks.size(); i += threads)
+		{
+			solver.push();
+			solver.addAssertion(m_conditionChecks[i].condition);
+			answers[i] = querySolver(solver, m_conditionChecks[i].expressionsToEvaluate);
+			solver.pop();
+		}
+	});
+	return answers;
+}
+
+void BMC::reportCondition(ConditionCheck const& _check, SolverAnswer const& _answer)
+{
+	if (_answer.error)
+		m_errorReporter.warning(8140_error, *_answer.error);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -907,30 +996,30 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_answer.result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_check.callStack.empty(), "");
 		std::ostringstream message;
-		message << "BMC: " << _description << " happens here.";
+		message << "BMC: " << _check.description << " happens here.";
 		std::ostringstream modelMessage;
 		modelMessage << "Counterexample:\n";
-		solAssert(values.size() == expressionNames.size(), "");
+		solAssert(_answer.values.size() == _check.expressionNames.size(), "");
 		map<string, string> sortedModel;
-		for (size_t i = 0; i < values.size(); ++i)
-			if (expressionsToEvaluate.at(i).name != values.at(i))
-				sortedModel[expressionNames.at(i)] = values.at(i);
+		for (size_t i = 0; i < _answer.values.size(); ++i)
+			if (_check.expressionsToEvaluate.at(i).name != _answer.values.at(i))
+				sortedModel[_check.expressionNames.at(i)] = _answer.values.at(i);
 
 		for (auto const& eval: sortedModel)
 			modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 
 		m_errorReporter.warning(
-			_errorHappens,
-			_location,
+			_check.errorHappens,
+			_check.location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(_check.callStack))
 			.append(move(secondaryLocation))
 		);
 		break;
@@ -938,17 +1027,15 @@ void BMC::checkCondition(
 	case smtutil::CheckResult::UNSATISFIABLE:
 		break;
 	case smtutil::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_check.errorMightHappen, _check.location, "BMC: " + _check.description + " might happen here.", secondaryLocation);
 		break;
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _check.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _check.location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -1012,22 +1099,37 @@ void BMC::checkBooleanNotConstant(
 pair<smtutil::CheckResult, vector<string>>
 BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
 {
-	smtutil::CheckResult result;
-	vector<string> values;
+	SolverAnswer answer = querySolver(*m_interface, _expressionsToEvaluate);
+	if (answer.error)
+		m_errorReporter.warning(8140_error, *answer.error);
+	return make_pair(answer.result, move(answer.values));
+}
+
+smtutil::CheckResult BMC::checkSatisfiable()
+{
+	return checkSatisfiableAndGenerateModel({}).first;
+}
+
+BMC::SolverAnswer BMC::querySolver(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
+{
+	SolverAnswer answer;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(answer.result, answer.values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
-		result = smtutil::CheckResult::ERROR;
+		answer.error = description;
+		answer.result = smtutil::CheckResult::ERROR;
 	}
 
-	for (string& value: values)
+	for (string& value: answer.values)
 	{
 		try
 		{
@@ -1037,12 +1139,7 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
-}
-
-smtutil::CheckResult BMC::checkSatisfiable()
-{
-	return checkSatisfiableAndGenerateModel({}).first;
+	return answer;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
@@ -24,6 +24,8 @@
  * - Underflow/Overflow
  * - Constant conditions
  * - Assertions
+ * The targets of a function are checked once the function has been visited. They are
+ * independent queries over the same encoding, so they can be checked concurrently.
  */
 
 #pragma once
@@ -35,9 +37,12 @@
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/SMTPortfolio.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -60,10 +65,12 @@ public:
 	BMC(
 		smt::EncodingContext& _context,
 		langutil::ErrorReporter& _errorReporter,
+		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		smtutil::SMTSolverChoice _enabledSolvers,
-		ModelCheckerSettings const& _settings
+		ModelCheckerSettings const& _settings,
+		unsigned _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>> _solvedTargets);
@@ -71,7 +78,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	static bool shouldInlineFunctionCall(FunctionCall const& _funCall, ContractDefinition const* _contract);
@@ -149,7 +156,30 @@ private:
 
 	/// Solver related.
 	//@{
+	/// A query that checks whether a verification target can be violated, together with
+	/// what is needed to report the result.
+	struct ConditionCheck
+	{
+		smtutil::Expression condition;
+		std::vector<CallStackEntry> callStack;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+		std::string description;
+	};
+	/// The answer of a solver to a query.
+	struct SolverAnswer
+	{
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// The description of the error if querying the solver failed.
+		std::optional<std::string> error;
+	};
+
 	/// Check that a condition can be satisfied.
+	/// Only creates the query, which is run and reported by checkVerificationTargets().
 	void checkCondition(
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
@@ -169,13 +199,47 @@ private:
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
+	/// Runs the queries created by checkCondition() and reports their results in the order
+	/// in which they were created.
+	void checkConditions();
+	/// Runs the queries on the solvers of m_targetSolvers, which are used by at most
+	/// m_parallelism threads.
+	/// @returns the answers to the queries.
+	std::vector<SolverAnswer> checkConditionsConcurrently();
+	void reportCondition(ConditionCheck const& _check, SolverAnswer const& _answer);
+
 	std::pair<smtutil::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
 
 	smtutil::CheckResult checkSatisfiable();
+
+	/// Checks the assertions of @a _solver and evaluates @a _expressionsToEvaluate if they are
+	/// satisfiable. Does not report anything, so it can be used by multiple threads on different solvers.
+	static SolverAnswer querySolver(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 	//@}
 
-	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	std::unique_ptr<smtutil::SMTPortfolio> m_interface;
+
+	/// Needed to create the solvers of m_targetSolvers.
+	//@{
+	std::map<h256, std::string> const m_smtlib2Responses;
+	ReadCallback::Callback const m_smtCallback;
+	smtutil::SMTSolverChoice const m_enabledSolvers;
+	/// Serializes the calls of m_smtCallback by the solvers of m_targetSolvers.
+	std::mutex m_smtCallbackMutex;
+	//@}
+
+	/// Maximum number of threads used to check verification targets.
+	unsigned const m_parallelism;
+	/// Solvers that check verification targets concurrently, at most one per thread. They are
+	/// created on demand and know all the variables declared in m_interface, but nothing else.
+	std::vector<std::unique_ptr<smtutil::SMTPortfolio>> m_targetSolvers;
+
+	/// Queries created by checkCondition() that were not yet run.
+	std::vector<ConditionCheck> m_conditionChecks;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -47,12 +47,16 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _parallelism is the maximum number of threads used by the BMC engine to check
+	/// the verification targets of a function.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
+		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
 		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
-		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All()
+		smtutil::SMTSolverChoice _enabledSolvers = smtutil::SMTSolverChoice::All(),
+		unsigned _parallelism = 1
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -72,6 +72,9 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::All();
 	std::optional<unsigned> timeout;
+	/// If set, BMC runs all solvers concurrently and uses the first answer to each query
+	/// instead of comparing the answers of all solvers.
+	bool raceSolvers = false;
 };
 
 }
@@ -23,6 +23,8 @@
 
 #include <libsmtutil/Sorts.h>
 
+#include <liblangutil/CharStreamProvider.h>
+
 #include <map>
 #include <optional>
 #include <vector>
@@ -126,8 +128,11 @@ public:
 	PredicateType type() const { return m_type; }
 
 	/// @returns a formatted string representing a call to this predicate
-	/// with _args.
-	std::string formatSummaryCall(std::vector<smtutil::Expression> const& _args) const;
+	/// with _args. The source text of program function calls is retrieved from @a _charStreamProvider.
+	std::string formatSummaryCall(
+		std::vector<smtutil::Expression> const& _args,
+		langutil::CharStreamProvider const& _charStreamProvider
+	) const;
 
 	/// @returns the values of the state variables from _args at the point
 	/// where this summary was reached.
@@ -39,9 +39,10 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
-SMTEncoder::SMTEncoder(smt::EncodingContext& _context):
+SMTEncoder::SMTEncoder(smt::EncodingContext& _context, CharStreamProvider const& _charStreamProvider):
 	m_errorReporter(m_smtErrors),
-	m_context(_context)
+	m_context(_context),
+	m_charStreamProvider(_charStreamProvider)
 {
 }
 
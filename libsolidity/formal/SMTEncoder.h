@@ -32,6 +32,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/interface/ReadFile.h>
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 
 #include <string>
@@ -51,7 +52,7 @@ namespace solidity::frontend
 class SMTEncoder: public ASTConstVisitor
 {
 public:
-	SMTEncoder(smt::EncodingContext& _context);
+	SMTEncoder(smt::EncodingContext& _context, langutil::CharStreamProvider const& _charStreamProvider);
 
 	/// @returns true if engine should proceed with analysis.
 	bool analyze(SourceUnit const& _sources);
@@ -403,6 +404,9 @@ protected:
 
 	/// Stores the context of the encoding.
 	smt::EncodingContext& m_context;
+
+	/// Provides the source text of expressions shown in counterexamples.
+	langutil::CharStreamProvider const& m_charStreamProvider;
 };
 
 }
@@ -0,0 +1,151 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/BytecodeCache.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::frontend;
+
+namespace
+{
+
+Json::Value toJson(evmasm::LinkerObject const& _object)
+{
+	Json::Value ret(Json::objectValue);
+	ret["bytecode"] = toHex(_object.bytecode);
+	ret["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		ret["linkReferences"][to_string(offset)] = library;
+	ret["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& immutable = ret["immutableReferences"][toString(hash)];
+		immutable["name"] = reference.first;
+		immutable["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			immutable["offsets"].append(Json::UInt64(offset));
+	}
+	return ret;
+}
+
+evmasm::LinkerObject linkerObjectFromJson(Json::Value const& _json)
+{
+	evmasm::LinkerObject ret;
+	ret.bytecode = fromHex(_json["bytecode"].asString(), WhenError::Throw);
+	for (auto const& offset: _json["linkReferences"].getMemberNames())
+		ret.linkReferences[stoul(offset)] = _json["linkReferences"][offset].asString();
+	for (auto const& hash: _json["immutableReferences"].getMemberNames())
+	{
+		Json::Value const& immutable = _json["immutableReferences"][hash];
+		auto& reference = ret.immutableReferences[u256(hash)];
+		reference.first = immutable["name"].asString();
+		for (auto const& offset: immutable["offsets"])
+			reference.second.push_back(static_cast<size_t>(offset.asUInt64()));
+	}
+	return ret;
+}
+
+}
+
+optional<BytecodeCache::Entry> BytecodeCache::load(h256 const& _key) const
+{
+	boost::filesystem::path path = boost::filesystem::path(m_directory) / (_key.hex() + ".json");
+	try
+	{
+		if (!boost::filesystem::is_regular_file(path))
+			return nullopt;
+
+		Json::Value json;
+		if (!jsonParseStrict(readFileAsString(path.string()), json) || !json.isArray())
+			return nullopt;
+
+		Entry entry;
+		for (Json::Value const& contractJson: json)
+		{
+			Contract contract;
+			contract.object = linkerObjectFromJson(contractJson["object"]);
+			contract.runtimeObject = linkerObjectFromJson(contractJson["runtimeObject"]);
+			contract.assembly = contractJson["assembly"].asString();
+			contract.assemblyJSON = contractJson["assemblyJSON"];
+			contract.sourceMapping = contractJson["sourceMapping"].asString();
+			contract.runtimeSourceMapping = contractJson["runtimeSourceMapping"].asString();
+			contract.generatedSources = contractJson["generatedSources"];
+			contract.runtimeGeneratedSources = contractJson["runtimeGeneratedSources"];
+			entry.emplace_back(contractJson["name"].asString(), move(contract));
+		}
+		return entry;
+	}
+	catch (std::exception const&)
+	{
+		// A corrupted entry is treated like a missing one.
+		return nullopt;
+	}
+}
+
+void BytecodeCache::store(h256 const& _key, Entry const& _entry) const
+{
+	Json::Value json(Json::arrayValue);
+	for (auto const& [name, contract]: _entry)
+	{
+		Json::Value contractJson(Json::objectValue);
+		contractJson["name"] = name;
+		contractJson["object"] = toJson(contract.object);
+		contractJson["runtimeObject"] = toJson(contract.runtimeObject);
+		contractJson["assembly"] = contract.assembly;
+		contractJson["assemblyJSON"] = contract.assemblyJSON;
+		contractJson["sourceMapping"] = contract.sourceMapping;
+		contractJson["runtimeSourceMapping"] = contract.runtimeSourceMapping;
+		contractJson["generatedSources"] = contract.generatedSources;
+		contractJson["runtimeGeneratedSources"] = contract.runtimeGeneratedSources;
+		json.append(move(contractJson));
+	}
+
+	boost::system::error_code error;
+	boost::filesystem::path directory(m_directory);
+	boost::filesystem::create_directories(directory, error);
+	if (error)
+		return;
+
+	// Other compiler processes might use the same directory, so the entry is written
+	// to a temporary file first and then renamed, which is atomic.
+	boost::filesystem::path path = directory / (_key.hex() + ".json");
+	boost::filesystem::path temporaryPath = directory / boost::filesystem::unique_path(_key.hex() + "-%%%%-%%%%.tmp");
+	{
+		ofstream file(temporaryPath.string(), ios::binary);
+		file << jsonCompactPrint(json);
+		if (!file)
+		{
+			file.close();
+			boost::filesystem::remove(temporaryPath, error);
+			return;
+		}
+	}
+	boost::filesystem::rename(temporaryPath, path, error);
+	if (error)
+		boost::filesystem::remove(temporaryPath, error);
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Content-addressed on-disk cache for the code generated for contracts.
+ */
+
+#pragma once
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores the outputs of the code generator in a directory, one file per entry, named by the
+ * hex representation of the key of the entry. The key has to cover everything the outputs
+ * depend on, the cache itself does not check anything.
+ */
+class BytecodeCache
+{
+public:
+	/// The outputs of the code generator for a single contract.
+	struct Contract
+	{
+		evmasm::LinkerObject object;
+		evmasm::LinkerObject runtimeObject;
+		std::string assembly;
+		Json::Value assemblyJSON;
+		std::string sourceMapping;
+		std::string runtimeSourceMapping;
+		Json::Value generatedSources;
+		Json::Value runtimeGeneratedSources;
+	};
+	/// The contracts of an entry by fully qualified name, in the order they were compiled.
+	using Entry = std::vector<std::pair<std::string, Contract>>;
+
+	explicit BytecodeCache(std::string _directory): m_directory(std::move(_directory)) {}
+
+	std::string const& directory() const { return m_directory; }
+
+	/// @returns the entry stored under @a _key or nullopt if there is none or it cannot be read.
+	std::optional<Entry> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key. Failing to write the entry is not an error,
+	/// it is compiled again the next time.
+	void store(util::h256 const& _key, Entry const& _entry) const;
+
+private:
+	std::string m_directory;
+};
+
+}
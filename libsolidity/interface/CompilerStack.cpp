@@ -61,6 +61,8 @@
 #include <libyul/AssemblyStack.h>
 #include <libyul/AsmParser.h>
 #include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -70,6 +72,7 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
@@ -84,24 +87,16 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
+	m_typeProvider{make_unique<TypeProvider>()},
+	m_sourceNames{make_unique<SourceNameRepository>()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 std::optional<CompilerStack::Remapping> CompilerStack::parseRemapping(string const& _remapping)
 {
@@ -139,6 +134,34 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setParallelism(unsigned _parallelism)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before compilation."));
+	solAssert(_parallelism > 0, "");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setTimeReport(bool _enabled)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must enable the time report before parsing."));
+	if (!_enabled)
+		m_timeReport.reset();
+	else if (!m_timeReport)
+		m_timeReport = make_unique<util::TimeReport>();
+}
+
+void CompilerStack::setBytecodeCacheDirectory(string const& _directory)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the bytecode cache directory before compilation."));
+	if (_directory.empty())
+		m_bytecodeCache.reset();
+	else
+		m_bytecodeCache.emplace(_directory);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -217,11 +240,16 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	if (m_timeReport)
+		m_timeReport->clear();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_parallelism = 1;
+		m_bytecodeCache.reset();
+		m_timeReport.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
@@ -236,8 +264,10 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_yulSubObjectsForEVM.clear();
 	m_errorReporter.clear();
-	TypeProvider::reset();
+	m_typeProvider = make_unique<TypeProvider>();
+	m_sourceNames = make_unique<SourceNameRepository>();
 }
 
 void CompilerStack::setSources(StringMap _sources)
@@ -246,6 +276,7 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	for (auto source: _sources)
 		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
 	m_stackState = SourcesSet;
@@ -253,6 +284,8 @@ void CompilerStack::setSources(StringMap _sources)
 
 bool CompilerStack::parse()
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	if (m_stackState != SourcesSet)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call parse only after the SourcesSet state."));
 	m_errorReporter.clear();
@@ -260,6 +293,7 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
+	util::TimeReport::Scope timeReportScope(m_timeReport.get(), "");
 	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
 
 	vector<string> sourcesToParse;
@@ -271,7 +305,11 @@ bool CompilerStack::parse()
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
 		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
+		{
+			// Scanning happens on demand while parsing, so it is included here.
+			util::TimeReport::Timer timer("parsing", {}, path);
+			source.ast = parser.parse(source.scanner);
+		}
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
@@ -302,6 +340,8 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call importASTs only before the SourcesSet state."));
 	m_sourceJsons = _sources;
@@ -324,13 +364,19 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
+	util::TimeReport::Scope timeReportScope(m_timeReport.get(), "");
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
 		if (source->ast)
+		{
+			util::TimeReport::Timer timer("analysis", "Scoper", *source->ast->annotation().path);
 			Scoper::assignScopes(*source->ast);
+		}
 
 	bool noErrors = true;
 
@@ -338,38 +384,65 @@ bool CompilerStack::analyze()
 	{
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "SyntaxChecker", *source->ast->annotation().path);
+				if (!syntaxChecker.checkSyntax(*source->ast))
+					noErrors = false;
+			}
 
 		DocStringTagParser DocStringTagParser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "DocStringTagParser", *source->ast->annotation().path);
+				if (!DocStringTagParser.parseDocStrings(*source->ast))
+					noErrors = false;
+			}
 
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "NameAndTypeResolver", *source->ast->annotation().path);
+				if (!resolver.registerDeclarations(*source->ast))
+					return false;
+			}
 
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "NameAndTypeResolver", *source->ast->annotation().path);
+				if (!resolver.performImports(*source->ast, sourceUnitsByName))
+					return false;
+			}
 
-		resolver.warnHomonymDeclarations();
+		{
+			util::TimeReport::Timer timer("analysis", "NameAndTypeResolver");
+			resolver.warnHomonymDeclarations();
+		}
 
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
-				return false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "NameAndTypeResolver", *source->ast->annotation().path);
+				if (!resolver.resolveNamesAndTypes(*source->ast))
+					return false;
+			}
 
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !declarationTypeChecker.check(*source->ast))
-				return false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "DeclarationTypeChecker", *source->ast->annotation().path);
+				if (!declarationTypeChecker.check(*source->ast))
+					return false;
+			}
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
@@ -379,13 +452,20 @@ bool CompilerStack::analyze()
 
 		for (Source const* source: m_sourceOrder)
 			if (auto sourceAst = source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "ContractLevelChecker", *sourceAst->annotation().path);
 				noErrors = contractLevelChecker.check(*sourceAst);
+			}
 
 		// Requires ContractLevelChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "DocStringAnalyser", *source->ast->annotation().path);
+				if (!docStringAnalyser.analyseDocStrings(*source->ast))
+					noErrors = false;
+			}
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -396,16 +476,25 @@ bool CompilerStack::analyze()
 		// which is only done one step later.
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
-				noErrors = false;
+			if (source->ast)
+			{
+				util::TimeReport::Timer timer("analysis", "TypeChecker", *source->ast->annotation().path);
+				if (!typeChecker.checkTypeRequirements(*source->ast))
+					noErrors = false;
+			}
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !postTypeChecker.check(*source->ast))
-					noErrors = false;
+				if (source->ast)
+				{
+					util::TimeReport::Timer timer("analysis", "PostTypeChecker", *source->ast->annotation().path);
+					if (!postTypeChecker.check(*source->ast))
+						noErrors = false;
+				}
+			util::TimeReport::Timer timer("analysis", "PostTypeChecker");
 			if (!postTypeChecker.finalize())
 				noErrors = false;
 		}
@@ -417,7 +506,10 @@ bool CompilerStack::analyze()
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						{
+							util::TimeReport::Timer timer("analysis", "ImmutableValidator", *source->ast->annotation().path);
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+						}
 
 		if (noErrors)
 		{
@@ -425,15 +517,23 @@ bool CompilerStack::analyze()
 			// variable is used before it is assigned to.
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !cfg.constructFlow(*source->ast))
-					noErrors = false;
+				if (source->ast)
+				{
+					util::TimeReport::Timer timer("analysis", "ControlFlowGraph", *source->ast->annotation().path);
+					if (!cfg.constructFlow(*source->ast))
+						noErrors = false;
+				}
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
 				for (Source const* source: m_sourceOrder)
-					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
-						noErrors = false;
+					if (source->ast)
+					{
+						util::TimeReport::Timer timer("analysis", "ControlFlowAnalyzer", *source->ast->annotation().path);
+						if (!controlFlowAnalyzer.analyze(*source->ast))
+							noErrors = false;
+					}
 			}
 		}
 
@@ -442,8 +542,12 @@ bool CompilerStack::analyze()
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
+				if (source->ast)
+				{
+					util::TimeReport::Timer timer("analysis", "StaticAnalyzer", *source->ast->annotation().path);
+					if (!staticAnalyzer.analyze(*source->ast))
+						noErrors = false;
+				}
 		}
 
 		if (noErrors)
@@ -454,16 +558,28 @@ bool CompilerStack::analyze()
 				if (source->ast)
 					ast.push_back(source->ast);
 
+			util::TimeReport::Timer timer("analysis", "ViewPureChecker");
 			if (!ViewPureChecker(ast, m_errorReporter).check())
 				noErrors = false;
 		}
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
+			ModelChecker modelChecker(
+				m_errorReporter,
+				*this,
+				m_smtlib2Responses,
+				m_modelCheckerSettings,
+				m_readFile,
+				m_enabledSMTSolvers,
+				m_parallelism
+			);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
+				{
+					util::TimeReport::Timer timer("analysis", "ModelChecker", *source->ast->annotation().path);
 					modelChecker.analyze(*source->ast);
+				}
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
 		}
 	}
@@ -520,6 +636,8 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisPerformed)
 		if (!parseAndAnalyze(_stopAfter))
@@ -531,8 +649,25 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
+	util::TimeReport::Scope timeReportScope(m_timeReport.get(), "");
+
+	if (m_generateEvmBytecode)
+		computeSourceHashes();
+
+	// Units of contracts that have to be generated and are then stored in the bytecode cache.
+	vector<pair<util::h256, vector<ContractDefinition const*>>> uncachedUnits;
+	if (bytecodeCacheUsable())
+		for (auto& unit: bytecodeCacheUnits())
+		{
+			util::TimeReport::Timer timer("bytecode cache");
+			util::h256 key = bytecodeCacheKey(unit);
+			if (!loadFromBytecodeCache(key, unit))
+				uncachedUnits.emplace_back(key, move(unit));
+		}
+
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	PendingAssemblies pendingAssemblies;
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
@@ -548,7 +683,7 @@ bool CompilerStack::compile(State _stopAfter)
 							if (m_viaIR)
 								generateEVMFromIR(*contract);
 							else
-								compileContract(*contract, otherCompilers);
+								compileContract(*contract, otherCompilers, pendingAssemblies);
 						}
 						if (m_generateEwasm)
 							generateEwasm(*contract);
@@ -557,6 +692,7 @@ bool CompilerStack::compile(State _stopAfter)
 					{
 						if (_error.type() != Error::Type::CodeGenerationError)
 							throw;
+						finishAssemblies(pendingAssemblies);
 						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
 						return false;
 					}
@@ -568,6 +704,7 @@ bool CompilerStack::compile(State _stopAfter)
 						)
 						{
 							string const* comment = _unimplementedError.comment();
+							finishAssemblies(pendingAssemblies);
 							m_errorReporter.error(
 								1834_error,
 								Error::Type::CodeGenerationError,
@@ -583,7 +720,13 @@ bool CompilerStack::compile(State _stopAfter)
 							throw;
 					}
 				}
+	finishAssemblies(pendingAssemblies);
 	m_stackState = CompilationSuccessful;
+	for (auto const& [key, unit]: uncachedUnits)
+	{
+		util::TimeReport::Timer timer("bytecode cache");
+		storeInBytecodeCache(key, unit);
+	}
 	this->link();
 	return true;
 }
@@ -641,6 +784,7 @@ evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _
 
 Json::Value CompilerStack::generatedSources(string const& _contractName, bool _runtime) const
 {
+	SourceNameRepository::Scope sourceNameScope(*m_sourceNames);
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
@@ -650,6 +794,9 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 		c.runtimeGeneratedSources :
 		c.generatedSources;
 	return sources.init([&]{
+		if (c.cached)
+			return _runtime ? c.cached->runtimeGeneratedSources : c.cached->generatedSources;
+
 		Json::Value sources{Json::arrayValue};
 		// If there is no compiler, then no bytecode was generated and thus no
 		// sources were generated.
@@ -689,7 +836,9 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 	Contract const& c = contract(_contractName);
 	if (!c.sourceMapping)
 	{
-		if (auto items = assemblyItems(_contractName))
+		if (c.cached)
+			c.sourceMapping.emplace(c.cached->sourceMapping);
+		else if (auto items = assemblyItems(_contractName))
 			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
 	}
 	return c.sourceMapping ? &*c.sourceMapping : nullptr;
@@ -703,7 +852,9 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 	Contract const& c = contract(_contractName);
 	if (!c.runtimeSourceMapping)
 	{
-		if (auto items = runtimeAssemblyItems(_contractName))
+		if (c.cached)
+			c.runtimeSourceMapping.emplace(c.cached->runtimeSourceMapping);
+		else if (auto items = runtimeAssemblyItems(_contractName))
 			c.runtimeSourceMapping.emplace(
 				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
 			);
@@ -748,7 +899,16 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	return contract(_contractName).yulIROptimized;
+	return yulIROptimized(contract(_contractName));
+}
+
+string const& CompilerStack::yulIROptimized(Contract const& _contract) const
+{
+	return _contract.yulIROptimized.init([&]{
+		if (!_contract.yulIROptimizedObject)
+			return string{};
+		return IRGenerator::printOptimized(*_contract.yulIROptimizedObject, m_evmVersion);
+	});
 }
 
 string const& CompilerStack::ewasm(string const& _contractName) const
@@ -792,6 +952,8 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyString(_sourceCodes);
+	else if (currentContract.cached)
+		return currentContract.cached->assembly;
 	else
 		return string();
 }
@@ -805,6 +967,8 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 	Contract const& currentContract = contract(_contractName);
 	if (currentContract.evmAssembly)
 		return currentContract.evmAssembly->assemblyJSON(sourceIndices());
+	else if (currentContract.cached)
+		return currentContract.cached->assemblyJSON;
 	else
 		return Json::Value();
 }
@@ -838,6 +1002,7 @@ Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 
 Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -856,6 +1021,7 @@ Json::Value const& CompilerStack::storageLayout(string const& _contractName) con
 
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -874,6 +1040,7 @@ Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -892,6 +1059,7 @@ Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -902,6 +1070,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json::Value CompilerStack::methodIdentifiers(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -929,6 +1098,7 @@ bytes CompilerStack::cborMetadata(string const& _contractName) const
 
 string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState < AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
 
@@ -945,6 +1115,14 @@ Scanner const& CompilerStack::scanner(string const& _sourceName) const
 	return *source(_sourceName).scanner;
 }
 
+CharStream const* CompilerStack::charStream(string const& _sourceName) const
+{
+	auto it = m_sources.find(_sourceName);
+	if (it == m_sources.end() || !it->second.scanner)
+		return nullptr;
+	return it->second.scanner->charStream().get();
+}
+
 SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 {
 	if (m_stackState < Parsed)
@@ -990,8 +1168,8 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 	int startColumn;
 	int endLine;
 	int endColumn;
-	tie(startLine, startColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.start);
-	tie(endLine, endColumn) = scanner(_sourceLocation.source->name()).translatePositionToLineColumn(_sourceLocation.end);
+	tie(startLine, startColumn) = scanner(*_sourceLocation.sourceName).translatePositionToLineColumn(_sourceLocation.start);
+	tie(endLine, endColumn) = scanner(*_sourceLocation.sourceName).translatePositionToLineColumn(_sourceLocation.end);
 
 	return make_tuple(++startLine, ++startColumn, ++endLine, ++endColumn);
 }
@@ -1018,6 +1196,36 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
+void CompilerStack::computeSourceHashes() const
+{
+	set<SourceUnit const*> referencedSourceUnits;
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (isRequestedContract(*contract))
+				{
+					referencedSourceUnits.insert(source->ast.get());
+					referencedSourceUnits += source->ast->referencedSourceUnits(true);
+					break;
+				}
+
+	vector<Source const*> sources;
+	for (auto const& source: m_sources)
+		if (referencedSourceUnits.count(source.second.ast.get()))
+			sources.emplace_back(&source.second);
+
+	util::TimeReport::Timer timer("metadata", "source hashes");
+	// Every source caches its own hashes, so they can be computed concurrently.
+	util::parallelFor(sources.size(), m_parallelism, [&](size_t _index) {
+		sources[_index]->keccak256();
+		if (!m_metadataLiteralSources)
+		{
+			sources[_index]->swarmHash();
+			sources[_index]->ipfsUrl();
+		}
+	});
+}
+
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsedAndImported, "");
@@ -1167,7 +1375,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers,
+	PendingAssemblies& _pendingAssemblies
 )
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1177,15 +1386,36 @@ void CompilerStack::compileContract(
 	if (_otherCompilers.count(&_contract))
 		return;
 
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _pendingAssemblies);
 
-	if (!_contract.canBeDeployed())
+	if (compiledContract.cached)
+	{
+		// Every contract that depends on this one is loaded from the cache as well and does not
+		// need its compiler. The warnings are still reported in the order of compilation.
+		finishAssemblies(_pendingAssemblies);
+		checkContractSize(_contract);
+		_otherCompilers[&_contract] = nullptr;
 		return;
+	}
 
-	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (!_contract.canBeDeployed())
+		return;
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	// The optimiser modifies the assemblies of dependencies once they are included as sub-assemblies,
+	// so they have to be assembled before.
+	for (auto const* dependency: _contract.annotation().contractDependencies)
+		if (any_of(
+			_pendingAssemblies.begin(),
+			_pendingAssemblies.end(),
+			[&](auto const& _job) { return _job.first == dependency; }
+		))
+			finishAssemblies(_pendingAssemblies, dependency);
+
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelism);
 	compiledContract.compiler = compiler;
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
@@ -1193,6 +1423,7 @@ void CompilerStack::compileContract(
 	try
 	{
 		// Run optimiser and compile the contract.
+		util::TimeReport::Timer timer("code generation", "ContractCompiler");
 		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
 	}
 	catch(evmasm::OptimizerException const&)
@@ -1202,35 +1433,66 @@ void CompilerStack::compileContract(
 
 	compiledContract.evmAssembly = compiler->assemblyPtr();
 	solAssert(compiledContract.evmAssembly, "");
-	try
-	{
-		// Assemble deployment (incl. runtime)  object.
-		compiledContract.object = compiledContract.evmAssembly->assemble();
-	}
-	catch(evmasm::AssemblyException const&)
-	{
-		solAssert(false, "Assembly exception for bytecode");
-	}
-	solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
-
 	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
 	solAssert(compiledContract.evmRuntimeAssembly, "");
-	try
-	{
-		// Assemble runtime object.
-		compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble();
-	}
-	catch(evmasm::AssemblyException const&)
+
+	// Assembling only reads the assemblies of the contract itself and the already assembled
+	// dependencies, so it can run concurrently with the code generation of other contracts.
+	_pendingAssemblies.emplace_back(&_contract, async(
+		m_parallelism > 1 ? launch::async : launch::deferred,
+		[&compiledContract, timeReportContext = util::TimeReport::context()]()
+		{
+			util::TimeReport::Scope timeReportScope(timeReportContext);
+			try
+			{
+				// Assemble deployment (incl. runtime)  object.
+				compiledContract.object = compiledContract.evmAssembly->assemble();
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for bytecode");
+			}
+			solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
+
+			try
+			{
+				// Assemble runtime object.
+				compiledContract.runtimeObject = compiledContract.evmRuntimeAssembly->assemble();
+			}
+			catch(evmasm::AssemblyException const&)
+			{
+				solAssert(false, "Assembly exception for deployed bytecode");
+			}
+		}
+	));
+	if (_pendingAssemblies.size() >= m_parallelism)
+		finishAssemblies(_pendingAssemblies, _pendingAssemblies.front().first);
+
+	_otherCompilers[compiledContract.contract] = compiler;
+}
+
+void CompilerStack::finishAssemblies(PendingAssemblies& _pendingAssemblies, ContractDefinition const* _contract)
+{
+	while (!_pendingAssemblies.empty())
 	{
-		solAssert(false, "Assembly exception for deployed bytecode");
+		auto [contract, job] = std::move(_pendingAssemblies.front());
+		_pendingAssemblies.pop_front();
+		job.get();
+		checkContractSize(*contract);
+
+		if (contract == _contract)
+			break;
 	}
+}
 
+void CompilerStack::checkContractSize(ContractDefinition const& _contract)
+{
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
 	//   contract creation fails with an out of gas error.
 	if (
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
-		compiledContract.runtimeObject.bytecode.size() > 0x6000
+		m_contracts.at(_contract.fullyQualifiedName()).runtimeObject.bytecode.size() > 0x6000
 	)
 		m_errorReporter.warning(
 			5574_error,
@@ -1240,8 +1502,164 @@ void CompilerStack::compileContract(
 			"Consider enabling the optimizer (with a low \"runs\" value!), "
 			"turning off revert strings, or using libraries."
 		);
+}
 
-	_otherCompilers[compiledContract.contract] = compiler;
+bool CompilerStack::bytecodeCacheUsable() const
+{
+	return m_bytecodeCache && m_generateEvmBytecode && !m_viaIR && !m_generateIR && !m_generateEwasm;
+}
+
+vector<vector<ContractDefinition const*>> CompilerStack::bytecodeCacheUnits() const
+{
+	// Same traversal as in compile() and compileContract().
+	vector<ContractDefinition const*> sequence;
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> visit = [&](ContractDefinition const& _contract)
+	{
+		if (!visited.insert(&_contract).second)
+			return;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			visit(*dependency);
+		if (_contract.canBeDeployed())
+			sequence.push_back(&_contract);
+	};
+	for (Source const* source: m_sourceOrder)
+		for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+			if (isRequestedContract(*contract))
+				visit(*contract);
+
+	map<ContractDefinition const*, size_t> position;
+	map<ContractDefinition const*, size_t> unitOf;
+	vector<vector<ContractDefinition const*>> units;
+	for (ContractDefinition const* contract: sequence)
+	{
+		size_t index = position.size();
+		position[contract] = index;
+		// Dependencies precede the contracts that depend on them, so they already have a unit.
+		set<size_t> connectedUnits;
+		for (auto const* dependency: contract->annotation().contractDependencies)
+			if (unitOf.count(dependency))
+				connectedUnits.insert(unitOf.at(dependency));
+
+		size_t unit = connectedUnits.empty() ? units.size() : *connectedUnits.begin();
+		if (unit == units.size())
+			units.emplace_back();
+		for (size_t other: connectedUnits)
+			if (other != unit)
+			{
+				for (ContractDefinition const* member: units[other])
+				{
+					unitOf[member] = unit;
+					units[unit].push_back(member);
+				}
+				units[other].clear();
+			}
+		unitOf[contract] = unit;
+		units[unit].push_back(contract);
+	}
+
+	vector<vector<ContractDefinition const*>> result;
+	for (auto& unit: units)
+		if (!unit.empty())
+		{
+			sort(unit.begin(), unit.end(), [&](auto const* _a, auto const* _b) {
+				return position.at(_a) < position.at(_b);
+			});
+			result.emplace_back(move(unit));
+		}
+	return result;
+}
+
+util::h256 CompilerStack::bytecodeCacheKey(vector<ContractDefinition const*> const& _unit) const
+{
+	map<string, unsigned> indices = sourceIndices();
+
+	string key = VersionString + "\n";
+	key += m_evmVersion.name() + "\n";
+	key += revertStringsToString(m_revertStrings) + "\n";
+	for (bool flag: {
+		m_optimiserSettings.runOrderLiterals,
+		m_optimiserSettings.runJumpdestRemover,
+		m_optimiserSettings.runPeephole,
+		m_optimiserSettings.runDeduplicate,
+		m_optimiserSettings.runCSE,
+		m_optimiserSettings.runConstantOptimiser,
+		m_optimiserSettings.optimizeStackAllocation,
+		m_optimiserSettings.runYulOptimiser
+	})
+		key += flag ? "1" : "0";
+	key += "\n" + m_optimiserSettings.yulOptimiserSteps + "\n";
+	key += to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + "\n";
+	// Index of the generated Yul sources.
+	key += to_string(indices.at(CompilerContext::yulUtilityFileName())) + "\n";
+
+	for (ContractDefinition const* contract: _unit)
+	{
+		key += contract->fullyQualifiedName() + "\n";
+		key += metadata(m_contracts.at(contract->fullyQualifiedName())) + "\n";
+
+		// The metadata contains the hashes of all imported sources. The code also depends on
+		// the IDs of their AST nodes and on their indices in the source mappings.
+		set<SourceUnit const*> sourceUnits = contract->sourceUnit().referencedSourceUnits(true);
+		sourceUnits.insert(&contract->sourceUnit());
+		map<string, SourceUnit const*> sourceUnitsByPath;
+		for (SourceUnit const* sourceUnit: sourceUnits)
+			sourceUnitsByPath[*sourceUnit->annotation().path] = sourceUnit;
+		for (auto const& [path, sourceUnit]: sourceUnitsByPath)
+			key += path + " " + to_string(sourceUnit->id()) + " " + to_string(indices.at(path)) + "\n";
+	}
+	return util::keccak256(key);
+}
+
+bool CompilerStack::loadFromBytecodeCache(util::h256 const& _key, vector<ContractDefinition const*> const& _unit)
+{
+	optional<BytecodeCache::Entry> entry = m_bytecodeCache->load(_key);
+	if (!entry || entry->size() != _unit.size())
+		return false;
+	for (size_t i = 0; i < _unit.size(); ++i)
+		if ((*entry)[i].first != _unit[i]->fullyQualifiedName())
+			return false;
+
+	for (auto& [name, cachedContract]: *entry)
+	{
+		Contract& contract = m_contracts.at(name);
+		contract.object = cachedContract.object;
+		contract.runtimeObject = cachedContract.runtimeObject;
+		contract.cached = make_shared<BytecodeCache::Contract const>(move(cachedContract));
+	}
+	return true;
+}
+
+void CompilerStack::storeInBytecodeCache(util::h256 const& _key, vector<ContractDefinition const*> const& _unit) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "");
+
+	StringMap sourceCodes;
+	for (auto const& [path, source]: m_sources)
+		sourceCodes[path] = source.scanner->source();
+
+	BytecodeCache::Entry entry;
+	for (ContractDefinition const* contract: _unit)
+	{
+		string const& name = contract->fullyQualifiedName();
+		Contract const& compiledContract = m_contracts.at(name);
+		solAssert(compiledContract.evmAssembly && !compiledContract.cached, "");
+
+		BytecodeCache::Contract cachedContract;
+		// Libraries are linked after the contracts were stored.
+		cachedContract.object = compiledContract.object;
+		cachedContract.runtimeObject = compiledContract.runtimeObject;
+		cachedContract.assembly = assemblyString(name, sourceCodes);
+		cachedContract.assemblyJSON = assemblyJSON(name);
+		if (string const* mapping = sourceMapping(name))
+			cachedContract.sourceMapping = *mapping;
+		if (string const* mapping = runtimeSourceMapping(name))
+			cachedContract.runtimeSourceMapping = *mapping;
+		cachedContract.generatedSources = generatedSources(name, false);
+		cachedContract.runtimeGeneratedSources = generatedSources(name, true);
+		entry.emplace_back(name, move(cachedContract));
+	}
+	m_bytecodeCache->store(_key, entry);
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1273,8 +1691,100 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	util::TimeReport::Timer timer("code generation", "IRGenerator");
+	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelism);
+	tie(compiledContract.yulIR, compiledContract.yulIROptimizedObject, compiledContract.yulIRUnoptimizedCode) =
+		generator.run(
+			_contract,
+			otherYulSources,
+			[&](ContractDefinition const& _subObject) { return yulIRSubObject(_subObject); }
+		);
+}
+
+shared_ptr<yul::Object> CompilerStack::yulIRSubObject(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.yulIROptimizedObject, "");
+	if (compiledContract.yulIRSubObject)
+		return compiledContract.yulIRSubObject;
+
+	// Without the optimizer, creation objects and sub-objects have the same code.
+	if (!m_optimiserSettings.runYulOptimiser)
+		return compiledContract.yulIRSubObject = compiledContract.yulIROptimizedObject;
+
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	util::TimeReport::Timer timer("code generation", "Yul optimizer");
+
+	yul::Object const& object = *compiledContract.yulIROptimizedObject;
+	auto subObject = make_shared<yul::Object>();
+	subObject->name = object.name;
+	solAssert(compiledContract.yulIRUnoptimizedCode, "");
+	subObject->code = move(compiledContract.yulIRUnoptimizedCode);
+	subObject->subObjects = object.subObjects;
+	subObject->subIndexByName = object.subIndexByName;
+	set<yul::Object const*> finishedObjects;
+	for (auto const& subNode: object.subObjects)
+		if (auto const* finishedObject = dynamic_cast<yul::Object const*>(subNode.get()))
+			finishedObjects.insert(finishedObject);
+
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	bool analysisSuccessful = stack.analyze(move(subObject), move(finishedObjects));
+	solAssert(analysisSuccessful, "");
+	stack.optimize(false);
+	return compiledContract.yulIRSubObject = stack.parserResult();
+}
+
+void CompilerStack::optimizeIRForEVM(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.yulIROptimizedObject, "");
+	if (compiledContract.yulIRObjectForEVM)
+		return;
+
+	if (!m_optimiserSettings.runYulOptimiser)
+	{
+		compiledContract.yulIRObjectForEVM = compiledContract.yulIROptimizedObject;
+		return;
+	}
+
+	// The optimized IR has to stay unchanged, so its code is copied. Sub-objects that were
+	// optimized once more for another object already are shared instead.
+	set<yul::Object const*> copiedObjects;
+	set<yul::Object const*> finishedObjects;
+	std::function<shared_ptr<yul::Object>(yul::Object const&)> copy = [&](yul::Object const& _object)
+	{
+		auto result = make_shared<yul::Object>();
+		result->name = _object.name;
+		result->code = make_shared<yul::Block>(std::get<yul::Block>(yul::ASTCopier{}(*_object.code)));
+		result->subIndexByName = _object.subIndexByName;
+		copiedObjects.insert(result.get());
+		for (shared_ptr<yul::ObjectNode> const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<yul::Object const*>(subNode.get()))
+			{
+				shared_ptr<yul::Object>& optimizedSubObject = m_yulSubObjectsForEVM[subObject];
+				if (!optimizedSubObject)
+					optimizedSubObject = copy(*subObject);
+				else if (!copiedObjects.count(optimizedSubObject.get()))
+					finishedObjects.insert(optimizedSubObject.get());
+				result->subObjects.emplace_back(optimizedSubObject);
+			}
+			else
+				// Data is never modified.
+				result->subObjects.emplace_back(subNode);
+		return result;
+	};
+
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	util::TimeReport::Timer timer("code generation", "Yul optimizer");
+
+	shared_ptr<yul::Object> object = copy(*compiledContract.yulIROptimizedObject);
+	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
+	stack.setParallelism(m_parallelism);
+	bool analysisSuccessful = stack.analyze(move(object), move(finishedObjects));
+	solAssert(analysisSuccessful, "");
+	stack.optimize();
+	compiledContract.yulIRObjectForEVM = stack.parserResult();
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1287,14 +1797,18 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulIROptimizedObject, "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
+	optimizeIRForEVM(_contract);
+
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	util::TimeReport::Timer timer("code generation", "Yul to EVM");
+
+	// The IR is already optimized and analyzed in EVM dialect.
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	stack.optimize();
+	stack.setParserResult(compiledContract.yulIRObjectForEVM);
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
@@ -1335,13 +1849,17 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
+	solAssert(compiledContract.yulIROptimizedObject, "");
 	if (!compiledContract.ewasm.empty())
 		return;
 
+	util::TimeReport::Scope timeReportScope(_contract.fullyQualifiedName());
+	util::TimeReport::Timer timer("code generation", "Ewasm");
+
 	// Re-parse the Yul IR in EVM dialect
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.setParallelism(m_parallelism);
+	stack.parseAndAnalyze("", yulIROptimized(compiledContract));
 
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
@@ -1618,6 +2136,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
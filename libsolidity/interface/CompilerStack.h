@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <libsolidity/interface/BytecodeCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -33,6 +34,7 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
@@ -42,12 +44,16 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/TimeReport.h>
 
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
 
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -66,6 +72,12 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+struct Block;
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -78,6 +90,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -86,7 +99,7 @@ class DeclarationContainer;
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
  */
-class CompilerStack: boost::noncopyable
+class CompilerStack: public langutil::CharStreamProvider, boost::noncopyable
 {
 public:
 	enum State {
@@ -166,6 +179,28 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used during code generation.
+	/// Code is still generated on the calling thread, but the assembly of a finished contract
+	/// is overlapped with the code generation of the contracts that do not depend on it.
+	/// The Yul optimizer processes the objects of a contract concurrently and the BMC engine
+	/// of the model checker checks the verification targets of a function concurrently.
+	/// Apart from the counterexamples found by the model checker, the output does not depend
+	/// on this setting.
+	/// Must be set before compilation.
+	void setParallelism(unsigned _parallelism);
+
+	/// Sets the directory of the on-disk cache for generated code. Contracts generated before with
+	/// the same sources and settings are loaded from the cache instead of generating their code again.
+	/// Only used if neither IR nor Ewasm is generated. An empty string disables the cache.
+	/// Gas estimates are not available for contracts loaded from the cache.
+	/// Must be set before compilation.
+	void setBytecodeCacheDirectory(std::string const& _directory);
+
+	/// Enables or disables measuring the time spent in the phases of the compilation,
+	/// per source and per contract. The measurements are returned by timeReport().
+	/// Must be set before parsing.
+	void setTimeReport(bool _enabled);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -241,6 +276,9 @@ public:
 	/// @returns the previously used scanner, useful for counting lines during error reporting.
 	langutil::Scanner const& scanner(std::string const& _sourceName) const;
 
+	/// @returns the character stream of the source @a _sourceName or nullptr if there is no such source.
+	langutil::CharStream const* charStream(std::string const& _sourceName) const override;
+
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
@@ -253,6 +291,10 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the time spent in the phases of the compilation so far or nullptr if the time
+	/// report is not enabled.
+	util::TimeReport const* timeReport() const { return m_timeReport.get(); }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -363,7 +405,18 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
-		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Optimized experimental Yul IR code, analyzed in EVM dialect.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
+		/// Code of @a yulIROptimizedObject (without its sub-objects) before the optimization.
+		/// Only kept until @a yulIRSubObject is created from it.
+		std::shared_ptr<yul::Block> yulIRUnoptimizedCode;
+		/// Optimized experimental Yul IR code as it is embedded into the contracts that create
+		/// this one: its own code is optimized as that of a sub-object, the sub-objects are
+		/// those of @a yulIROptimizedObject. Shared by all these contracts.
+		std::shared_ptr<yul::Object> yulIRSubObject;
+		/// Copy of @a yulIROptimizedObject that is optimized once more and then assembled.
+		std::shared_ptr<yul::Object> yulIRObjectForEVM;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized experimental Yul IR code as text.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -375,6 +428,8 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		/// Outputs loaded from the bytecode cache instead of generating code (no compiler or assemblies).
+		std::shared_ptr<BytecodeCache::Contract const> cached;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
@@ -393,18 +448,57 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// Assembly jobs of contracts whose code has been generated, in the order they were scheduled.
+	using PendingAssemblies = std::deque<std::pair<ContractDefinition const*, std::future<void>>>;
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _pendingAssemblies receives the job assembling the bytecode of the contract.
+	///                           Dependencies are finished before the contract is compiled.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		PendingAssemblies& _pendingAssemblies
 	);
 
+	/// Reports a warning if the runtime code of @a _contract is larger than allowed by EIP-170.
+	void checkContractSize(ContractDefinition const& _contract);
+
+	/// @returns true if the bytecode cache is set and the generated outputs can be stored in it.
+	bool bytecodeCacheUsable() const;
+	/// @returns the deployable contracts compile() generates code for, in the order of compilation,
+	/// split into units that are independent of each other. Contracts that depend on each other
+	/// are in the same unit, because the optimiser modifies the assemblies of dependencies.
+	std::vector<std::vector<ContractDefinition const*>> bytecodeCacheUnits() const;
+	/// @returns the key of @a _unit in the bytecode cache.
+	/// It covers the compiler version, the settings, the metadata of the contracts and the
+	/// AST IDs and source indices of all the sources they import.
+	util::h256 bytecodeCacheKey(std::vector<ContractDefinition const*> const& _unit) const;
+	/// Loads the contracts of @a _unit from the bytecode cache entry @a _key.
+	/// @returns false if there is no matching entry.
+	bool loadFromBytecodeCache(util::h256 const& _key, std::vector<ContractDefinition const*> const& _unit);
+	/// Stores the generated outputs of the contracts of @a _unit in the bytecode cache as entry @a _key.
+	void storeInBytecodeCache(util::h256 const& _key, std::vector<ContractDefinition const*> const& _unit) const;
+
+	/// Waits for the assembly jobs in @a _pendingAssemblies up to and including the one of
+	/// @a _contract (all of them if it is null) and reports their warnings in scheduling order.
+	void finishAssemblies(PendingAssemblies& _pendingAssemblies, ContractDefinition const* _contract = nullptr);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
 
+	/// @returns the Yul IR object of a single contract as it is embedded into the contracts
+	/// that create it. It is created on the first call.
+	/// Depends on output generated by generateIR.
+	std::shared_ptr<yul::Object> yulIRSubObject(ContractDefinition const& _contract);
+
+	/// Optimize a copy of the Yul IR of a single contract once more, which is the code that
+	/// is assembled. Sub-objects are optimized once for all objects that contain them.
+	/// Depends on output generated by generateIR.
+	void optimizeIRForEVM(ContractDefinition const& _contract);
+
 	/// Generate EVM representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
@@ -429,6 +523,11 @@ private:
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
 
+	/// Computes the hashes of the sources that are part of the metadata of the contracts
+	/// compile() generates code for, using up to m_parallelism threads. The hashes are cached
+	/// per source and shared by the metadata of all contracts.
+	void computeSourceHashes() const;
+
 	/// @returns the metadata JSON as a compact string for the given contract.
 	std::string createMetadata(Contract const& _contract) const;
 
@@ -455,6 +554,10 @@ private:
 	/// This will generate the metadata and store it in the Contract object if it is not present yet.
 	std::string const& metadata(Contract const&) const;
 
+	/// @returns the optimized Yul IR code as text.
+	/// This will print the code and store it in the Contract object if it is not present yet.
+	std::string const& yulIROptimized(Contract const&) const;
+
 	/// @returns the offset of the entry point of the given function into the list of assembly items
 	/// or zero if it is not found or does not exist.
 	size_t functionEntryPoint(
@@ -467,6 +570,9 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	unsigned m_parallelism = 1;
+	std::optional<BytecodeCache> m_bytecodeCache;
+	std::unique_ptr<util::TimeReport> m_timeReport;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
@@ -483,9 +589,18 @@ private:
 	std::map<std::string, Json::Value> m_sourceJsons;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
+	/// Owns the types of the sources. Installed with a TypeProvider::Scope by every function
+	/// that may create types, so that the stack can be used from any thread.
+	std::unique_ptr<TypeProvider> m_typeProvider;
+	/// Owns the names of the sources referred to by source locations. Installed with a
+	/// SourceNameRepository::Scope by every function that may scan or parse code.
+	std::unique_ptr<langutil::SourceNameRepository> m_sourceNames;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
+	/// Sub-objects of the optimized Yul IR of the contracts (like runtime objects and created
+	/// contracts), optimized once more for the EVM, by the original object.
+	std::map<yul::Object const*, std::shared_ptr<yul::Object>> m_yulSubObjectsForEVM;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
 	bool m_metadataLiteralSources = false;
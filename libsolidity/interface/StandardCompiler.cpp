@@ -33,11 +33,13 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TimeReport.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
 #include <optional>
+#include <shared_mutex>
 
 using namespace std;
 using namespace solidity;
@@ -71,6 +73,22 @@ Json::Value formatError(
 	return error;
 }
 
+Json::Value timeReportToJson(util::TimeReport const& _timeReport)
+{
+	Json::Value ret = Json::objectValue;
+	for (auto const& [scope, phases]: _timeReport.scopes())
+		for (auto const& [name, phase]: phases)
+		{
+			Json::Value& phaseJson = ret[scope][name];
+			phaseJson["nanoseconds"] = Json::UInt64(phase.time.count());
+			phaseJson["calls"] = Json::UInt64(phase.calls);
+			// Only the executables count allocations, so they are left out otherwise.
+			if (util::countAllocations)
+				phaseJson["allocations"] = Json::UInt64(phase.allocations);
+		}
+	return ret;
+}
+
 Json::Value formatFatalError(string const& _type, string const& _message)
 {
 	Json::Value output = Json::objectValue;
@@ -82,9 +100,9 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
 	Json::Value sourceLocation;
-	if (location && location->source && !location->source->name().empty())
+	if (location && location->sourceName && !location->sourceName->empty())
 	{
-		sourceLocation["file"] = location->source->name();
+		sourceLocation["file"] = *location->sourceName;
 		sourceLocation["start"] = location->start;
 		sourceLocation["end"] = location->end;
 	}
@@ -108,6 +126,7 @@ Json::Value formatSecondarySourceLocation(SecondarySourceLocation const* _second
 }
 
 Json::Value formatErrorWithException(
+	CharStreamProvider const& _charStreamProvider,
 	util::Exception const& _exception,
 	bool const& _warning,
 	string const& _type,
@@ -118,7 +137,11 @@ Json::Value formatErrorWithException(
 {
 	string message;
 	// TODO: consider enabling color
-	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(_exception, _type);
+	string formattedMessage = SourceReferenceFormatter::formatExceptionInformation(
+		_exception,
+		_type,
+		_charStreamProvider
+	);
 
 	if (string const* description = boost::get_error_info<util::errinfo_comment>(_exception))
 		message = ((_message.length() > 0) ? (_message + ":") : "") + *description;
@@ -428,13 +451,13 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings", "stopAfter", "timeReport", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "targets", "timeout"};
+	static set<string> keys{"engine", "raceSolvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -668,7 +691,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 			{
 				if (!url.isString())
 					return formatFatalError("JSONError", "URL must be a string.");
-				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
+				ReadCallback::Result result = readCallback()(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
 				if (result.success)
 				{
 					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
@@ -700,6 +723,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 				));
 			}
 		}
+		else if (m_artifactCache && !hash.empty())
+		{
+			auto cached = m_sourceCache.end();
+			try
+			{
+				cached = m_sourceCache.find(util::h256(hash));
+			}
+			catch (util::BadHexCharacter const&)
+			{
+			}
+			if (cached == m_sourceCache.end())
+				return formatFatalError("JSONError", "No content given for \"" + sourceName + "\" and its hash is not in the cache.");
+			ret.sources[sourceName] = cached->second;
+		}
 		else
 			return formatFatalError("JSONError", "Invalid input source specified.");
 	}
@@ -770,6 +807,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
+	if (settings.isMember("timeReport"))
+	{
+		if (!settings["timeReport"].isBool())
+			return formatFatalError("JSONError", "\"settings.timeReport\" must be a Boolean.");
+		ret.timeReport = settings["timeReport"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -925,18 +976,26 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		if (!modelCheckerSettings["raceSolvers"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean.");
+		ret.modelCheckerSettings.raceSolvers = modelCheckerSettings["raceSolvers"].asBool();
+	}
+
 	return { std::move(ret) };
 }
 
 Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	CompilerStack compilerStack(readCallback());
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	compilerStack.setSources(sourceList);
 	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
 		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	compilerStack.setParallelism(_inputsAndSettings.parallelism);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
@@ -968,6 +1027,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			Error const& err = dynamic_cast<Error const&>(*error);
 
 			errors.append(formatErrorWithException(
+				compilerStack,
 				*error,
 				err.type() == Error::Type::Warning,
 				err.typeName(),
@@ -981,6 +1041,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (Error const& _error)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_error,
 			false,
 			_error.typeName(),
@@ -1001,6 +1062,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (CompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_exception,
 			false,
 			"CompilerError",
@@ -1011,6 +1073,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (InternalCompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_exception,
 			false,
 			"InternalCompilerError",
@@ -1021,6 +1084,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (UnimplementedFeatureError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_exception,
 			false,
 			"UnimplementedFeatureError",
@@ -1031,6 +1095,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (yul::YulException const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_exception,
 			false,
 			"YulException",
@@ -1041,6 +1106,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (smtutil::SMTLogicError const& _exception)
 	{
 		errors.append(formatErrorWithException(
+			compilerStack,
 			_exception,
 			false,
 			"SMTLogicException",
@@ -1228,13 +1294,18 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 	Json::Value output = Json::objectValue;
 
+	// The locations of the code are only used while the output is created.
+	SourceNameRepository sourceNames;
+	SourceNameRepository::Scope sourceNameScope(sourceNames);
 	AssemblyStack stack(
 		_inputsAndSettings.evmVersion,
 		AssemblyStack::Language::StrictAssembly,
 		_inputsAndSettings.optimiserSettings
 	);
+	stack.setParallelism(_inputsAndSettings.parallelism);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
+	util::TimeReport::Scope timeReportScope(sourceName);
 
 	// Inconsistent state - stop here to receive error reports from users
 	if (!stack.parseAndAnalyze(sourceName, sourceContents) && stack.errors().empty())
@@ -1248,6 +1319,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 			auto err = dynamic_pointer_cast<Error const>(error);
 
 			errors.append(formatErrorWithException(
+				stack,
 				*error,
 				err->type() == Error::Type::Warning,
 				err->typeName(),
@@ -1318,20 +1390,70 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	// Compilations running concurrently on other threads hold this mutex in shared mode.
+	// The repository can only be reset if no other compilation is using it.
+	static shared_mutex yulStringRepositoryMutex;
+	{
+		unique_lock<shared_mutex> resetLock(yulStringRepositoryMutex, try_to_lock);
+		if (resetLock.owns_lock())
+			YulStringRepository::reset();
+	}
 
 	try
 	{
+		shared_lock<shared_mutex> lock(yulStringRepositoryMutex);
+		m_reads.clear();
+		m_uncacheableRead = false;
 		auto parsed = parseInput(_input);
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+
+		optional<util::h256> key;
+		if (m_artifactCache)
+		{
+			// Only the sources of the latest request are kept, which is what a client
+			// re-sending its unchanged files can refer to.
+			map<string, util::h256> sourceHashes;
+			m_sourceCache.clear();
+			for (auto const& [name, content]: settings.sources)
+			{
+				util::h256 hash = util::keccak256(content);
+				sourceHashes[name] = hash;
+				m_sourceCache[hash] = content;
+			}
+			// A time report describes the compilation itself, so its output is neither
+			// taken from nor stored in the output cache.
+			if (!settings.timeReport)
+			{
+				key = cacheKey(_input, sourceHashes);
+				auto cached = m_outputCache.find(*key);
+				if (cached != m_outputCache.end() && cachedReadsAreValid(cached->second.reads))
+				{
+					m_outputCacheOrder.splice(m_outputCacheOrder.begin(), m_outputCacheOrder, cached->second.position);
+					return cached->second.output;
+				}
+			}
+		}
+
+		util::TimeReport timeReport;
+		bool const timeReportRequested = settings.timeReport;
+		Json::Value output;
+		{
+			util::TimeReport::Scope timeReportScope(timeReportRequested ? &timeReport : nullptr, "");
+			if (settings.language == "Solidity")
+				output = compileSolidity(std::move(settings));
+			else if (settings.language == "Yul")
+				output = compileYul(std::move(settings));
+			else
+				return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+		}
+		if (timeReportRequested)
+			output["timeReport"] = timeReportToJson(timeReport);
+
+		if (key && !m_uncacheableRead)
+			cacheOutput(*key, output);
+		return output;
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -1351,6 +1473,83 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 	}
 }
 
+void StandardCompiler::enableArtifactCache(bool _enable)
+{
+	m_artifactCache = _enable;
+	if (!m_artifactCache)
+	{
+		m_sourceCache.clear();
+		m_outputCache.clear();
+		m_outputCacheOrder.clear();
+	}
+}
+
+void StandardCompiler::cacheOutput(util::h256 const& _key, Json::Value const& _output)
+{
+	auto cached = m_outputCache.find(_key);
+	if (cached != m_outputCache.end())
+	{
+		// The cached output was outdated because one of the files it read has changed.
+		cached->second.output = _output;
+		cached->second.reads = std::move(m_reads);
+		m_outputCacheOrder.splice(m_outputCacheOrder.begin(), m_outputCacheOrder, cached->second.position);
+		return;
+	}
+
+	if (m_outputCache.size() >= c_maxCachedOutputs)
+	{
+		m_outputCache.erase(m_outputCacheOrder.back());
+		m_outputCacheOrder.pop_back();
+	}
+	m_outputCacheOrder.push_front(_key);
+	m_outputCache[_key] = CachedOutput{_output, std::move(m_reads), m_outputCacheOrder.begin()};
+}
+
+ReadCallback::Callback StandardCompiler::readCallback()
+{
+	if (!m_artifactCache || !m_readFile)
+		return m_readFile;
+
+	return [this](string const& _kind, string const& _data)
+	{
+		ReadCallback::Result result = m_readFile(_kind, _data);
+		if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+		{
+			if (result.success)
+				m_reads[_data] = util::keccak256(result.responseOrErrorMessage);
+			else
+				m_reads[_data] = nullopt;
+		}
+		else
+			m_uncacheableRead = true;
+		return result;
+	};
+}
+
+util::h256 StandardCompiler::cacheKey(Json::Value const& _input, map<string, util::h256> const& _sourceHashes)
+{
+	Json::Value input = _input;
+	for (auto const& [name, hash]: _sourceHashes)
+	{
+		input["sources"][name] = Json::objectValue;
+		input["sources"][name]["keccak256"] = "0x" + hash.hex();
+	}
+	return util::keccak256(util::jsonCompactPrint(input));
+}
+
+bool StandardCompiler::cachedReadsAreValid(map<string, optional<util::h256>> const& _reads) const
+{
+	for (auto const& [path, hash]: _reads)
+	{
+		ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), path);
+		if (result.success != hash.has_value())
+			return false;
+		if (result.success && util::keccak256(result.responseOrErrorMessage) != *hash)
+			return false;
+	}
+	return true;
+}
+
 string StandardCompiler::compile(string const& _input) noexcept
 {
 	Json::Value input;
@@ -25,6 +25,8 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <list>
+#include <map>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -54,6 +56,16 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Replaces the callback used to read files for import statements.
+	void setReadCallback(ReadCallback::Callback _readFile) { m_readFile = std::move(_readFile); }
+
+	/// Keeps source contents and compilation outputs between calls to compile().
+	/// Sources that were already seen can then be given by their "keccak256" alone and
+	/// a request that only repeats an earlier one is answered without recompiling.
+	/// Any other request is compiled from scratch: the analysis of unchanged sources is not reused.
+	/// Used by long-lived compilers such as `solc --server`.
+	void enableArtifactCache(bool _enable = true);
+
 private:
 	struct InputsAndSettings
 	{
@@ -73,6 +85,8 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		unsigned parallelism = 1;
+		bool timeReport = false;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -82,7 +96,46 @@ private:
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// @returns the read callback to use for the current compilation. If the artifact cache
+	/// is enabled, it records the files that were read so that cached outputs can be validated.
+	ReadCallback::Callback readCallback();
+
+	/// @returns the key of @a _input in the output cache. The sources are replaced by
+	/// their hashes @a _sourceHashes so that it does not matter how their content was supplied.
+	static util::h256 cacheKey(Json::Value const& _input, std::map<std::string, util::h256> const& _sourceHashes);
+	/// @returns true if all files read through the callback for a cached output (@a _reads) are unchanged.
+	bool cachedReadsAreValid(std::map<std::string, std::optional<util::h256>> const& _reads) const;
+
+	struct CachedOutput
+	{
+		Json::Value output;
+		/// Hashes of the files read through the callback, nullopt if reading failed.
+		std::map<std::string, std::optional<util::h256>> reads;
+		/// Position of the key of this output in m_outputCacheOrder.
+		std::list<util::h256>::iterator position;
+	};
+
+	/// Adds @a _output to the output cache, removing the least recently used output
+	/// if the cache is full.
+	void cacheOutput(util::h256 const& _key, Json::Value const& _output);
+
+	/// Maximum number of outputs kept in m_outputCache.
+	static size_t constexpr c_maxCachedOutputs = 16;
+
 	ReadCallback::Callback m_readFile;
+
+	bool m_artifactCache = false;
+	/// Contents of the sources of the last compilation, by keccak256 hash.
+	std::map<util::h256, std::string> m_sourceCache;
+	/// Outputs of earlier compilations by the key of their input. Whole outputs are memoized,
+	/// nothing that was computed for an input is reused for a different one.
+	std::map<util::h256, CachedOutput> m_outputCache;
+	/// Keys of m_outputCache, the most recently used first.
+	std::list<util::h256> m_outputCacheOrder;
+	/// Files read through the callback during the current compilation.
+	std::map<std::string, std::optional<util::h256>> m_reads;
+	/// Set if the callback was used for anything but reading files during the current compilation.
+	bool m_uncacheableRead = false;
 };
 
 }
@@ -137,6 +137,41 @@ Chunks buildNextLevel(Chunks& _currentLevel)
 	return nextLevel;
 }
 
+/// @returns the data node of the chunk @a _data of a file. The node is hashed while it is
+/// encoded, so that the data is not copied.
+Chunk dataChunk(bytesConstRef _data)
+{
+	bytes lengthAsVarint = varintEncoding(_data.size());
+
+	// Type: File
+	bytes header{0x08, 0x02};
+	if (!_data.empty())
+		// Data (length delimited bytes)
+		header += bytes{0x12} + lengthAsVarint;
+	// filesize: length as varint
+	bytes trailer = bytes{0x18} + lengthAsVarint;
+
+	// PBDag:
+	// Data: (length delimited bytes)
+	bytes prefix = bytes{0x0a} + varintEncoding(header.size() + _data.size() + trailer.size());
+
+	// Multihash: sha2-256, 256 bits
+	picosha2::hash256_one_by_one hasher;
+	hasher.process(prefix.begin(), prefix.end());
+	hasher.process(header.begin(), header.end());
+	hasher.process(_data.begin(), _data.end());
+	hasher.process(trailer.begin(), trailer.end());
+	hasher.finish();
+	bytes hash(picosha2::k_digest_size);
+	hasher.get_hash_bytes(hash.begin(), hash.end());
+
+	return Chunk(
+		bytes{0x12, 0x20} + hash,
+		_data.size(),
+		prefix.size() + header.size() + _data.size() + trailer.size()
+	);
+}
+
 /// Builds a tree starting from the bottom level where nodes are data nodes.
 /// Data nodes should be calculated and passed as the only level in chunk levels
 /// Each next level is calculated as following:
@@ -153,7 +188,7 @@ bytes groupChunksBottomUp(Chunks _currentLevel)
 }
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
 	size_t const maxChunkSize = 1024 * 256;
 	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
@@ -163,41 +198,17 @@ bytes solidity::util::ipfsHash(string _data)
 
 	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
 	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
-
-		bytes protobufEncodedData;
-		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
-		{
-			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
-		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
-
-		// PBDag:
-		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
-
-		// Multihash: sha2-256, 256 bits
-		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
+		bytesConstRef chunkBytes = bytesConstRef(_data).cropped(
+			chunkIndex * maxChunkSize,
+			min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize)
 		);
+		allChunks.emplace_back(dataChunk(chunkBytes));
 	}
 
 	return groupChunksBottomUp(std::move(allChunks));
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -22,10 +22,13 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <array>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <utility>
 
 using namespace std;
 
@@ -171,6 +174,126 @@ inline void hash(
 	memset(a, 0, 200);
 }
 
+/// The rate of Keccak-256 in bytes, i.e. the size of the input blocks.
+size_t constexpr keccak256Rate = 200 - (256 / 4);
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define SOL_KECCAK_MULTI_BUFFER
+
+/******** Multi-buffer Keccak-f[1600] ********/
+
+/// Number of inputs hashed at the same time by the multi-buffer permutation.
+size_t constexpr multiBufferLanes = 4;
+
+/// The same word of the states of multiBufferLanes independent permutations, so that
+/// every operation of the permutation is applied to all of them with one SIMD instruction.
+using Lanes = uint64_t __attribute__((vector_size(8 * multiBufferLanes)));
+using LanesPermutation = void(*)(Lanes*);
+
+/// Rotation offsets of the rho step by index x + 5 * y of the word.
+constexpr unsigned rotations[25] = {
+	 0,  1, 62, 28, 27,
+	36, 44,  6, 55, 20,
+	 3, 10, 43, 25, 39,
+	41, 45, 15, 21,  8,
+	18,  2, 61, 56, 14
+};
+
+/// @returns the index the pi step moves the word with index @a _index to.
+constexpr size_t piTarget(size_t _index) { return _index / 5 + 5 * ((2 * (_index % 5) + 3 * (_index / 5)) % 5); }
+
+// The steps are expanded over all words at compile time, so that the rotations are by constants.
+template <size_t... X>
+inline void theta(Lanes* _a, std::index_sequence<X...>)
+{
+	Lanes c[5];
+	((c[X] = _a[X] ^ _a[X + 5] ^ _a[X + 10] ^ _a[X + 15] ^ _a[X + 20]), ...);
+	Lanes d[5];
+	((d[X] = c[(X + 4) % 5] ^ (c[(X + 1) % 5] << 1) ^ (c[(X + 1) % 5] >> 63)), ...);
+	((_a[X] ^= d[X], _a[X + 5] ^= d[X], _a[X + 10] ^= d[X], _a[X + 15] ^= d[X], _a[X + 20] ^= d[X]), ...);
+}
+
+template <size_t... I>
+inline void rhoPiChi(Lanes* _a, std::index_sequence<I...>)
+{
+	Lanes b[25];
+	((b[piTarget(I)] = (_a[I] << rotations[I]) | (_a[I] >> ((64 - rotations[I]) % 64))), ...);
+	((_a[I] = b[I] ^ (~b[I / 5 * 5 + (I + 1) % 5] & b[I / 5 * 5 + (I + 2) % 5])), ...);
+}
+
+inline void keccakfLanes(Lanes* _a)
+{
+	for (uint64_t roundConstant: RC)
+	{
+		theta(_a, std::make_index_sequence<5>{});
+		rhoPiChi(_a, std::make_index_sequence<25>{});
+		_a[0] ^= roundConstant;
+	}
+}
+
+// The same permutation compiled for different instruction sets. The baseline version uses
+// pairs of SSE2 registers, the AVX-512 version has native rotations.
+__attribute__((flatten)) void keccakfLanesSSE2(Lanes* _a) { keccakfLanes(_a); }
+__attribute__((flatten, target("avx2"))) void keccakfLanesAVX2(Lanes* _a) { keccakfLanes(_a); }
+__attribute__((flatten, target("avx512f,avx512vl"))) void keccakfLanesAVX512(Lanes* _a) { keccakfLanes(_a); }
+
+/// @returns the fastest version of the multi-buffer permutation the processor supports.
+LanesPermutation lanesPermutation()
+{
+	static LanesPermutation const permutation = []() -> LanesPermutation {
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+			return keccakfLanesAVX512;
+		else if (__builtin_cpu_supports("avx2"))
+			return keccakfLanesAVX2;
+		else
+			return keccakfLanesSSE2;
+	}();
+	return permutation;
+}
+
+/// Computes the Keccak-256 hashes of multiBufferLanes inputs that need the same number of blocks.
+void keccak256Lanes(std::array<bytesConstRef, multiBufferLanes> const& _inputs, std::array<h256*, multiBufferLanes> const& _outputs)
+{
+	LanesPermutation const permutation = lanesPermutation();
+	size_t const blocks = _inputs[0].size() / keccak256Rate + 1;
+	Lanes state[25] = {};
+	for (size_t block = 0; block < blocks; ++block)
+	{
+		for (size_t lane = 0; lane < multiBufferLanes; ++lane)
+		{
+			uint8_t const* data = _inputs[lane].data() + block * keccak256Rate;
+			uint8_t lastBlock[keccak256Rate] = {0};
+			if (block + 1 == blocks)
+			{
+				// Pad the last block like hash() does.
+				size_t const remaining = _inputs[lane].size() - block * keccak256Rate;
+				if (remaining > 0)
+					memcpy(lastBlock, data, remaining);
+				lastBlock[remaining] ^= 0x01;
+				lastBlock[keccak256Rate - 1] ^= 0x80;
+				data = lastBlock;
+			}
+			// x86-64 is little-endian, so the bytes of a block can be loaded as words directly.
+			for (size_t word = 0; word < keccak256Rate / 8; ++word)
+			{
+				uint64_t value;
+				memcpy(&value, data + 8 * word, 8);
+				state[word][lane] ^= value;
+			}
+		}
+		permutation(state);
+	}
+	for (size_t lane = 0; lane < multiBufferLanes; ++lane)
+		for (size_t word = 0; word < h256::size / 8; ++word)
+		{
+			uint64_t const value = state[word][lane];
+			memcpy(_outputs[lane]->data() + 8 * word, &value, 8);
+		}
+}
+
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -180,7 +303,80 @@ h256 keccak256(bytesConstRef _input)
 	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
 	// the way the round size (or window or whatever it was) is calculated.
 	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	hash(output.data(), output.size, _input.data(), _input.size(), keccak256Rate, 0x01);
+	return output;
+}
+
+vector<h256> keccak256(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> hashes(_inputs.size());
+#ifdef SOL_KECCAK_MULTI_BUFFER
+	// Inputs can only share a multi-buffer permutation if they need the same number of blocks.
+	map<size_t, vector<size_t>> inputsByBlocks;
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		inputsByBlocks[_inputs[i].size() / keccak256Rate].push_back(i);
+
+	for (auto const& [blocks, indices]: inputsByBlocks)
+	{
+		size_t i = 0;
+		for (; i + multiBufferLanes <= indices.size(); i += multiBufferLanes)
+		{
+			array<bytesConstRef, multiBufferLanes> inputs;
+			array<h256*, multiBufferLanes> outputs;
+			for (size_t lane = 0; lane < multiBufferLanes; ++lane)
+			{
+				inputs[lane] = _inputs[indices[i + lane]];
+				outputs[lane] = &hashes[indices[i + lane]];
+			}
+			keccak256Lanes(inputs, outputs);
+		}
+		for (; i < indices.size(); ++i)
+			hashes[indices[i]] = keccak256(_inputs[indices[i]]);
+	}
+#else
+	for (size_t i = 0; i < _inputs.size(); ++i)
+		hashes[i] = keccak256(_inputs[i]);
+#endif
+	return hashes;
+}
+
+vector<h256> keccak256(vector<string> const& _inputs)
+{
+	vector<bytesConstRef> inputs;
+	for (string const& input: _inputs)
+		inputs.emplace_back(input);
+	return keccak256(inputs);
+}
+
+void IncrementalKeccak256::absorb(bytesConstRef _input)
+{
+	uint8_t const* input = _input.data();
+	size_t length = _input.size();
+	while (length > 0)
+	{
+		size_t blockPart = min(length, keccak256Rate - m_blockOffset);
+		xorin(m_state + m_blockOffset, input, blockPart);
+		input += blockPart;
+		length -= blockPart;
+		m_blockOffset += blockPart;
+		if (m_blockOffset == keccak256Rate)
+		{
+			keccakf(m_state);
+			m_blockOffset = 0;
+		}
+	}
+}
+
+h256 IncrementalKeccak256::digest() const
+{
+	// Padding and squeezing as in hash(), on a copy of the state.
+	alignas(uint64_t) uint8_t state[Plen];
+	memcpy(state, m_state, Plen);
+	state[m_blockOffset] ^= 0x01;
+	state[keccak256Rate - 1] ^= 0x80;
+	keccakf(state);
+	h256 output;
+	setout(state, output.data(), output.size);
 	return output;
 }
 
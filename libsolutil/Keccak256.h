@@ -26,7 +26,9 @@
 
 #include <libsolutil/FixedHash.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -43,4 +45,31 @@ inline h256 keccak256(std::string const& _input) { return keccak256(bytesConstRe
 /// Calculate Keccak-256 hash of the given input (presented as a FixedHash), returns a 256-bit hash.
 template<unsigned N> inline h256 keccak256(FixedHash<N> const& _input) { return keccak256(_input.ref()); }
 
+/// Calculate the Keccak-256 hashes of all given inputs.
+/// On x86-64, several inputs of similar length are hashed at the same time using SIMD instructions,
+/// so this is faster than hashing the inputs one by one.
+std::vector<h256> keccak256(std::vector<bytesConstRef> const& _inputs);
+
+/// Calculate the Keccak-256 hashes of all given inputs (presented as binary-filled strings).
+std::vector<h256> keccak256(std::vector<std::string> const& _inputs);
+
+/// Keccak-256 hash of an input that is given piece by piece.
+/// A copy continues independently of the original, so the hashes of inputs with a common
+/// prefix only have to process the prefix once.
+class IncrementalKeccak256
+{
+public:
+	/// Appends @a _input to the input hashed so far.
+	void absorb(bytesConstRef _input);
+	void absorb(std::string const& _input) { absorb(bytesConstRef(_input)); }
+
+	/// @returns the Keccak-256 hash of the input absorbed so far.
+	h256 digest() const;
+
+private:
+	alignas(uint64_t) uint8_t m_state[200] = {};
+	/// Number of bytes of the current block that were already absorbed.
+	size_t m_blockOffset = 0;
+};
+
 }
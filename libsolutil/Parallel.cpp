@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <libsolutil/TimeReport.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+
+namespace
+{
+
+/// Threads that are kept alive between calls of parallelFor(), so that the thread-local state
+/// of the compiler (like the rule lists of the optimisers) is only built once per thread.
+/// The pool grows whenever there are more tasks than idle threads. Calls can be nested:
+/// The caller never waits for a queued task, only for the ones that already started, and
+/// every thread takes part in the loop it is waiting for.
+class WorkerPool
+{
+public:
+	static WorkerPool& instance()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	~WorkerPool()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_taskAvailable.notify_all();
+		for (thread& worker: m_workers)
+			worker.join();
+	}
+
+	/// Queues @a _count copies of @a _task and starts new threads if there are fewer than
+	/// @a _count idle ones. Tasks that are still queued from earlier calls are not counted,
+	/// since they return immediately once their loop is done.
+	/// If a thread cannot be started, some of the tasks run later or never.
+	void post(function<void()> const& _task, size_t _count)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 0; i < _count; ++i)
+			m_tasks.push_back(_task);
+		while (m_idleWorkers < _count)
+			try
+			{
+				m_workers.emplace_back([this]() { work(); });
+				++m_idleWorkers;
+			}
+			catch (system_error const&)
+			{
+				break;
+			}
+		for (size_t i = 0; i < _count; ++i)
+			m_taskAvailable.notify_one();
+	}
+
+private:
+	WorkerPool() = default;
+
+	void work()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		while (true)
+		{
+			m_taskAvailable.wait(lock, [&]() { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+				return;
+			function<void()> task = move(m_tasks.front());
+			m_tasks.pop_front();
+			--m_idleWorkers;
+			lock.unlock();
+			task();
+			lock.lock();
+			++m_idleWorkers;
+		}
+	}
+
+	mutex m_mutex;
+	condition_variable m_taskAvailable;
+	deque<function<void()>> m_tasks;
+	vector<thread> m_workers;
+	/// Number of workers that wait for a task or are about to.
+	size_t m_idleWorkers = 0;
+	bool m_stopping = false;
+};
+
+/// State of one call of parallelFor() that is shared with the tasks it posts to the pool,
+/// which can outlive the call if no thread got to them in time.
+struct Loop
+{
+	mutex loopMutex;
+	condition_variable jobFinished;
+	size_t next = 0;
+	size_t running = 0;
+	vector<exception_ptr> exceptions;
+};
+
+}
+
+void util::parallelFor(size_t _count, unsigned _parallelism, function<void(size_t)> const& _job)
+{
+	if (_parallelism <= 1 || _count <= 1)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_job(i);
+		return;
+	}
+
+	auto loop = make_shared<Loop>();
+	loop->exceptions.resize(_count);
+	TimeReport::Context const timeReportContext = TimeReport::context();
+	// Does not touch _job or timeReportContext once all jobs have been started,
+	// because they are owned by the caller.
+	auto work = [loop, _count, &_job, &timeReportContext]()
+	{
+		unique_lock<mutex> lock(loop->loopMutex);
+		if (loop->next >= _count)
+			return;
+		TimeReport::Scope timeReportScope(timeReportContext);
+		while (loop->next < _count)
+		{
+			size_t index = loop->next++;
+			++loop->running;
+			lock.unlock();
+			exception_ptr exception;
+			try
+			{
+				_job(index);
+			}
+			catch (...)
+			{
+				exception = current_exception();
+			}
+			lock.lock();
+			loop->exceptions[index] = move(exception);
+			--loop->running;
+		}
+		loop->jobFinished.notify_all();
+	};
+
+	WorkerPool::instance().post(work, min<size_t>(_parallelism, _count) - 1);
+	work();
+	{
+		unique_lock<mutex> lock(loop->loopMutex);
+		loop->jobFinished.wait(lock, [&]() { return loop->running == 0; });
+	}
+
+	for (exception_ptr const& exception: loop->exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
@@ -0,0 +1,41 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Helpers for running independent jobs on multiple threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace solidity::util
+{
+
+/// Calls @a _job for every index in [0, _count), using up to @a _parallelism threads
+/// (including the calling thread). The calls can happen in any order.
+/// If calls throw, the exception of the call with the lowest index is rethrown
+/// once all calls have finished.
+/// If @a _parallelism is at most one, the calls are made on the calling thread in order
+/// of their index and the first exception is propagated immediately.
+/// The other threads record their phases in the time report of the calling thread.
+/// They come from a pool that is kept for the lifetime of the process, so that their
+/// thread-local state is reused by later calls. Calls can be nested.
+void parallelFor(size_t _count, unsigned _parallelism, std::function<void(size_t)> const& _job);
+
+}
@@ -63,16 +63,27 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 	return swarmHashSimple(ref, _length);
 }
 
+/// @returns the binary Merkle tree hash of @a _data, whose size has to be 64 times a power of two.
+/// All nodes of a level of the tree are hashed at once.
 h256 bmtHash(bytesConstRef _data)
 {
-	if (_data.size() <= 64)
-		return keccak256(_data);
-
-	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	vector<bytesConstRef> segments;
+	for (size_t i = 0; i < _data.size(); i += 64)
+		segments.emplace_back(_data.cropped(i, 64));
+	vector<h256> level = keccak256(segments);
+
+	bytes pairs;
+	while (level.size() > 1)
+	{
+		pairs.clear();
+		for (h256 const& hash: level)
+			pairs += hash.asBytes();
+		segments.clear();
+		for (size_t i = 0; i < pairs.size(); i += 64)
+			segments.emplace_back(bytesConstRef(&pairs).cropped(i, 64));
+		level = keccak256(segments);
+	}
+	return level.front();
 }
 
 h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
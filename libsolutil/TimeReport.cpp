@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/TimeReport.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+thread_local TimeReport* currentReport = nullptr;
+thread_local string currentScope;
+thread_local TimeReport::Timer* currentTimer = nullptr;
+
+}
+
+TimeReport::Scope::Scope(TimeReport* _report, string_view _scope):
+	m_previousReport(currentReport)
+{
+	if (_report)
+		currentReport = _report;
+	if (!currentReport)
+		return;
+	m_previousScope = move(currentScope);
+	currentScope = _scope;
+}
+
+TimeReport::Scope::~Scope()
+{
+	if (!currentReport)
+		return;
+	currentReport = m_previousReport;
+	currentScope = move(m_previousScope);
+}
+
+TimeReport::Timer::Timer(string_view _phase):
+	Timer(_phase, {})
+{
+}
+
+TimeReport::Timer::Timer(string_view _phase, string_view _step):
+	Timer(_phase, _step, currentScope)
+{
+}
+
+TimeReport::Timer::Timer(string_view _phase, string_view _step, string_view _scope)
+{
+	if (!currentReport)
+		return;
+	m_report = currentReport;
+	m_parent = currentTimer;
+	m_phase = _phase;
+	if (!_step.empty())
+		m_phase.append(": ").append(_step);
+	m_scope = _scope;
+	currentTimer = this;
+	m_startAllocations = allocationCount;
+	m_start = chrono::steady_clock::now();
+}
+
+TimeReport::Timer::~Timer()
+{
+	if (!m_report)
+		return;
+	Phase phase;
+	phase.time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - m_start);
+	phase.allocations = allocationCount - m_startAllocations;
+	phase.calls = 1;
+
+	currentTimer = m_parent;
+	if (m_parent)
+	{
+		m_parent->m_nestedTime += phase.time;
+		m_parent->m_nestedAllocations += phase.allocations;
+	}
+
+	phase.time -= m_nestedTime;
+	phase.allocations -= m_nestedAllocations;
+	m_report->record(m_scope, m_phase, phase);
+}
+
+TimeReport::Context TimeReport::context()
+{
+	return {currentReport, currentReport ? currentScope : string{}};
+}
+
+void TimeReport::record(string const& _scope, string const& _name, Phase const& _phase)
+{
+	lock_guard<mutex> lock(m_mutex);
+	Phase& phase = m_scopes[_scope][_name];
+	phase.time += _phase.time;
+	phase.allocations += _phase.allocations;
+	phase.calls += _phase.calls;
+}
+
+map<string, TimeReport::Phases> TimeReport::scopes() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_scopes;
+}
+
+void TimeReport::clear()
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_scopes.clear();
+}
@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Collection of the time spent in the phases of a compilation.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/// Number of allocations made by the calling thread. It is only counted by executables
+/// that replace the global operator new (like solc) and only while countAllocations is set,
+/// otherwise it stays zero.
+inline thread_local uint64_t allocationCount = 0;
+/// Set by executables that count allocations in allocationCount when a time report is requested.
+/// The allocations of the phases are only meaningful, and only reported, while it is set.
+inline std::atomic<bool> countAllocations{false};
+
+/**
+ * Wall-clock time and allocations of the phases of a compilation, grouped by scope
+ * (usually a source or a contract).
+ *
+ * Phases are measured by Timer objects. Nothing is measured unless a report was installed
+ * for the calling thread using a Scope object. The time of a nested phase is not included
+ * in the time of the enclosing phase, so the times of all phases of a thread add up to the
+ * time spent in measured phases.
+ */
+class TimeReport
+{
+public:
+	struct Phase
+	{
+		std::chrono::nanoseconds time{0};
+		uint64_t allocations = 0;
+		size_t calls = 0;
+	};
+	/// Phases by name.
+	using Phases = std::map<std::string, Phase>;
+
+	/// The report and scope of a thread, used to continue measuring on another thread.
+	struct Context
+	{
+		TimeReport* report = nullptr;
+		std::string scope;
+	};
+
+	/**
+	 * Sets the report and the scope of the calling thread for its lifetime.
+	 */
+	class Scope
+	{
+	public:
+		/// Installs @a _report and records phases under @a _scope. If @a _report is null,
+		/// the report of the calling thread is kept, if there is one.
+		Scope(TimeReport* _report, std::string_view _scope);
+		/// Installs the report and the scope of @a _context.
+		explicit Scope(Context const& _context): Scope(_context.report, _context.scope) {}
+		/// Keeps the report of the calling thread and records phases under @a _scope.
+		explicit Scope(std::string_view _scope): Scope(nullptr, _scope) {}
+		~Scope();
+
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		TimeReport* m_previousReport = nullptr;
+		std::string m_previousScope;
+	};
+
+	/**
+	 * Measures the time between its construction and destruction, minus the time of the
+	 * timers nested inside, and records it in the report of the calling thread.
+	 */
+	class Timer
+	{
+	public:
+		/// Measures @a _phase in the current scope.
+		explicit Timer(std::string_view _phase);
+		/// Measures step @a _step of @a _phase in the current scope, recorded as "<phase>: <step>".
+		Timer(std::string_view _phase, std::string_view _step);
+		/// Measures step @a _step of @a _phase in scope @a _scope instead of the current scope.
+		Timer(std::string_view _phase, std::string_view _step, std::string_view _scope);
+		~Timer();
+
+		Timer(Timer const&) = delete;
+		Timer& operator=(Timer const&) = delete;
+
+	private:
+		TimeReport* m_report = nullptr;
+		Timer* m_parent = nullptr;
+		std::string m_phase;
+		std::string m_scope;
+		std::chrono::steady_clock::time_point m_start;
+		uint64_t m_startAllocations = 0;
+		std::chrono::nanoseconds m_nestedTime{0};
+		uint64_t m_nestedAllocations = 0;
+	};
+
+	/// @returns the report and the scope of the calling thread.
+	static Context context();
+
+	/// Adds @a _phase to the phase called @a _name in @a _scope.
+	void record(std::string const& _scope, std::string const& _name, Phase const& _phase);
+	/// @returns the phases recorded so far, by scope.
+	std::map<std::string, Phases> scopes() const;
+	void clear();
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<std::string, Phases> m_scopes;
+};
+
+}
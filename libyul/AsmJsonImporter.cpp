@@ -53,10 +53,7 @@ T AsmJsonImporter::createAsmNode(Json::Value const& _node)
 {
 	T r;
 	r.location = createSourceLocation(_node);
-	yulAssert(
-		r.location.source && 0 <= r.location.start && r.location.start <= r.location.end,
-		"Invalid source location in Asm AST"
-	);
+	yulAssert(r.location.hasText(), "Invalid source location in Asm AST");
 	return r;
 }
 
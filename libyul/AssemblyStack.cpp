@@ -44,6 +44,9 @@
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/Parallel.h>
+
+#include <functional>
 
 using namespace std;
 using namespace solidity;
@@ -77,10 +80,23 @@ Scanner const& AssemblyStack::scanner() const
 	return *m_scanner;
 }
 
-bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
+CharStream const* AssemblyStack::charStream(string const& _sourceName) const
+{
+	if (!m_scanner || m_scanner->charStream()->name() != _sourceName)
+		return nullptr;
+	return m_scanner->charStream().get();
+}
+
+bool AssemblyStack::parseAndAnalyze(
+	std::string const& _sourceName,
+	std::string const& _source,
+	map<YulString, vector<shared_ptr<Object>>> const& _subObjects,
+	set<Object const*> _finishedObjects
+)
 {
 	m_errors.clear();
 	m_analysisSuccessful = false;
+	m_finishedObjects = move(_finishedObjects);
 	m_scanner = make_shared<Scanner>(CharStream(_source, _sourceName));
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(m_scanner, false);
 	if (!m_errorReporter.errors().empty())
@@ -88,10 +104,56 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
 
+	std::function<Object*(Object&, YulString)> findObject = [&](Object& _current, YulString _name) -> Object*
+	{
+		if (_current.name == _name)
+			return &_current;
+		for (auto& subNode: _current.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				if (!m_finishedObjects.count(subObject))
+					if (Object* result = findObject(*subObject, _name))
+						return result;
+		return nullptr;
+	};
+	for (auto const& [name, subObjects]: _subObjects)
+	{
+		Object* object = findObject(*m_parserResult, name);
+		yulAssert(object, "Object <" + name.str() + "> not found.");
+		for (shared_ptr<Object> const& subObject: subObjects)
+		{
+			yulAssert(subObject && subObject->code, "");
+			yulAssert(!object->subIndexByName.count(subObject->name), "");
+			object->subIndexByName[subObject->name] = object->subObjects.size();
+			object->subObjects.emplace_back(subObject);
+		}
+	}
+
 	return analyzeParsed();
 }
 
-void AssemblyStack::optimize()
+void AssemblyStack::setParserResult(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "");
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = move(_object);
+	m_finishedObjects = {m_parserResult.get()};
+	m_analysisSuccessful = true;
+}
+
+bool AssemblyStack::analyze(shared_ptr<Object> _object, set<Object const*> _finishedObjects)
+{
+	yulAssert(_object, "");
+	m_errors.clear();
+	m_scanner.reset();
+	m_parserResult = move(_object);
+	m_finishedObjects = move(_finishedObjects);
+	return analyzeParsed();
+}
+
+void AssemblyStack::optimize(bool _isCreation)
 {
 	if (!m_optimiserSettings.runYulOptimiser)
 		return;
@@ -100,7 +162,7 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	optimize(*m_parserResult, _isCreation);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -113,9 +175,11 @@ void AssemblyStack::translate(AssemblyStack::Language _targetLanguage)
 		m_language == Language::StrictAssembly && _targetLanguage == Language::Ewasm,
 		"Invalid language combination"
 	);
+	yulAssert(m_finishedObjects.empty(), "Cannot translate finished objects.");
 
 	*m_parserResult = EVMToEwasmTranslator(
-		languageToDialect(m_language, m_evmVersion)
+		languageToDialect(m_language, m_evmVersion),
+		*this
 	).run(*parserResult());
 
 	m_language = _targetLanguage;
@@ -130,6 +194,8 @@ bool AssemblyStack::analyzeParsed()
 
 bool AssemblyStack::analyzeParsed(Object& _object)
 {
+	if (m_finishedObjects.count(&_object))
+		return true;
 	yulAssert(_object.code, "");
 	_object.analysisInfo = make_shared<AsmAnalysisInfo>();
 
@@ -170,12 +236,33 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 
 void AssemblyStack::optimize(Object& _object, bool _isCreation)
 {
-	yulAssert(_object.code, "");
-	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
+	// The optimizer only ever looks at the names of the sub-objects of an object,
+	// so all objects can be optimized concurrently. They are collected in the
+	// order in which they used to be optimized: sub-objects before their parents.
+	// Finished objects are optimized already, objects shared by several parents are
+	// optimized only once.
+	vector<pair<Object*, bool>> objects;
+	set<Object const*> collected;
+	std::function<void(Object&, bool)> collect = [&](Object& _current, bool _currentIsCreation)
+	{
+		if (m_finishedObjects.count(&_current) || !collected.insert(&_current).second)
+			return;
+		yulAssert(_current.code, "");
+		yulAssert(_current.analysisInfo, "");
+		for (auto& subNode: _current.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				collect(*subObject, false);
+		objects.emplace_back(&_current, _currentIsCreation);
+	};
+	collect(_object, _isCreation);
+
+	util::parallelFor(objects.size(), m_parallelism, [&](size_t _index) {
+		optimizeSingle(*objects[_index].first, objects[_index].second);
+	});
+}
 
+void AssemblyStack::optimizeSingle(Object& _object, bool _isCreation)
+{
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
@@ -237,15 +324,15 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, false, m_optimiserSettings.optimizeStackAllocation);
 
+	// There is no scanner if the object was not parsed by this stack.
+	string const sourceName = m_scanner && m_scanner->charStream() ? m_scanner->charStream()->name() : "";
+
 	MachineAssemblyObject creationObject;
 	creationObject.bytecode = make_shared<evmasm::LinkerObject>(assembly.assemble());
 	yulAssert(creationObject.bytecode->immutableReferences.empty(), "Leftover immutables.");
 	creationObject.assembly = assembly.assemblyString();
 	creationObject.sourceMappings = make_unique<string>(
-		evmasm::AssemblyItem::computeSourceMapping(
-			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-		)
+		evmasm::AssemblyItem::computeSourceMapping(assembly.items(), {{sourceName, 0}})
 	);
 
 	MachineAssemblyObject runtimeObject;
@@ -256,10 +343,7 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 		runtimeObject.bytecode = make_shared<evmasm::LinkerObject>(runtimeAssembly.assemble());
 		runtimeObject.assembly = runtimeAssembly.assemblyString();
 		runtimeObject.sourceMappings = make_unique<string>(
-			evmasm::AssemblyItem::computeSourceMapping(
-				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
-			)
+			evmasm::AssemblyItem::computeSourceMapping(runtimeAssembly.items(), {{sourceName, 0}})
 		);
 	}
 	return {std::move(creationObject), std::move(runtimeObject)};
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 
@@ -32,8 +33,11 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -56,7 +60,7 @@ struct MachineAssemblyObject
  * Full assembly stack that can support EVM-assembly and Yul as input and EVM, EVM1.5 and
  * Ewasm as output.
  */
-class AssemblyStack
+class AssemblyStack: public langutil::CharStreamProvider
 {
 public:
 	enum class Language { Yul, Assembly, StrictAssembly, Ewasm };
@@ -75,13 +79,47 @@ public:
 	/// @returns the scanner used during parsing
 	langutil::Scanner const& scanner() const;
 
+	/// @returns the character stream of the source @a _sourceName if it was the one parsed last.
+	langutil::CharStream const* charStream(std::string const& _sourceName) const override;
+
 	/// Runs parsing and analysis steps, returns false if input cannot be assembled.
+	/// Before the analysis, @a _subObjects are appended to the sub-objects of the objects
+	/// named like their keys. The objects in @a _finishedObjects are sub-objects of these that
+	/// have to be the result of parserResult() of stacks with the same language and EVM version.
+	/// They are treated as finished: they can be shared with other objects and are neither
+	/// analyzed nor optimized again.
+	/// Multiple calls overwrite the previous state.
+	bool parseAndAnalyze(
+		std::string const& _sourceName,
+		std::string const& _source,
+		std::map<YulString, std::vector<std::shared_ptr<Object>>> const& _subObjects = {},
+		std::set<Object const*> _finishedObjects = {}
+	);
+
+	/// Uses @a _object instead of parsing and analyzing a source. It has to be the result of
+	/// parserResult() of a stack with the same language and EVM version, so that it can be
+	/// assembled without being analyzed again. It is treated as finished, so optimize()
+	/// does not change it.
 	/// Multiple calls overwrite the previous state.
-	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
+	void setParserResult(std::shared_ptr<Object> _object);
+
+	/// Analyzes @a _object instead of a parsed source. The objects in @a _finishedObjects are
+	/// sub-objects of @a _object that have to be the result of parserResult() of stacks with the
+	/// same language and EVM version. They are treated as finished: they can be shared with
+	/// other objects and are neither analyzed nor optimized again.
+	/// Multiple calls overwrite the previous state.
+	bool analyze(std::shared_ptr<Object> _object, std::set<Object const*> _finishedObjects);
+
+	/// Sets the maximum number of threads used by the optimizer. The object and all its
+	/// sub-objects are optimized independently of each other, so they can be processed
+	/// concurrently. The output does not depend on this setting.
+	void setParallelism(unsigned _parallelism) { m_parallelism = _parallelism; }
 
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// @param _isCreation whether the top-level object is optimized as creation code or,
+	/// like all its sub-objects, as the code of a sub-object.
+	void optimize(bool _isCreation = true);
 
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
@@ -111,15 +149,20 @@ private:
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
 	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes the code of @a _object, but not that of its sub-objects.
+	void optimizeSingle(yul::Object& _object, bool _isCreation);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	unsigned m_parallelism = 1;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
+	/// Objects that may be shared with other objects and must not be modified.
+	std::set<yul::Object const*> m_finishedObjects;
 	langutil::ErrorList m_errors;
 	langutil::ErrorReporter m_errorReporter;
 
@@ -106,10 +106,14 @@ vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 			subIndexIt != object->subIndexByName.end(),
 			"Assembly object <" + _qualifiedName.str() + "> not found or does not contain code."
 		);
+		// Sub-objects can be shared between objects, so their subIDs are not stored in them.
+		size_t subId = 0;
+		for (size_t i = 0; i < subIndexIt->second; ++i)
+			if (dynamic_cast<Object const*>(object->subObjects[i].get()))
+				++subId;
 		object = dynamic_cast<Object const*>(object->subObjects[subIndexIt->second].get());
 		yulAssert(object, "Assembly object <" + _qualifiedName.str() + "> not found or does not contain code.");
-		yulAssert(object->subId != numeric_limits<size_t>::max(), "");
-		path.push_back({object->subId});
+		path.push_back(subId);
 	}
 
 	return path;
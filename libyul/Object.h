@@ -74,6 +74,8 @@ public:
 	std::set<YulString> qualifiedDataNames() const;
 
 	/// @returns vector of subIDs if possible to reach subobject with @a _qualifiedName, throws otherwise
+	/// The subID of an object is its position among the sub-objects of its parent that are not
+	/// data, which is the ID the EVM object compiler assigns to it.
 	/// For "B.C" should return vector of two values if success (subId of B and subId of C in B).
 	/// In object "A" if called for "A.B" will return only one value (subId for B)
 	/// will return empty vector for @a _qualifiedName that equals to object name.
@@ -85,9 +87,6 @@ public:
 	/// The path must not lead to a @a Data object (will throw in that case).
 	std::vector<size_t> pathToSubObject(YulString _qualifiedName) const;
 
-	/// sub id for object if it is subobject of another object, max value if it is not subobject
-	size_t subId = std::numeric_limits<size_t>::max();
-
 	std::shared_ptr<Block> code;
 	std::vector<std::shared_ptr<ObjectNode>> subObjects;
 	std::map<YulString, size_t> subIndexByName;
@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Entry of the per-thread cache of recently used strings.
+struct CacheEntry
+{
+	uint64_t generation = 0;
+	uint64_t hash = 0;
+	size_t id = 0;
+};
+
+/// Direct-mapped cache, indexed by the lowest bits of the hash.
+thread_local array<CacheEntry, 1024> t_cache;
+
+mutex g_resetCallbacksMutex;
+
+}
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& chunk: m_chunks)
+		delete[] chunk.load(memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+
+	uint64_t generation = m_generation.load(memory_order_relaxed);
+	CacheEntry& cached = t_cache[h & (t_cache.size() - 1)];
+	if (cached.generation == generation && cached.hash == h && idToString(cached.id) == _string)
+		return Handle{cached.id, h};
+
+	Shard& shard = m_shards[h >> (64 - shardBits)];
+	size_t id = 0;
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		auto range = shard.hashToID.equal_range(h);
+		for (auto it = range.first; it != range.second && id == 0; ++it)
+			if (idToString(it->second) == _string)
+				id = it->second;
+		if (id == 0)
+		{
+			id = m_nextID.fetch_add(1, memory_order_relaxed);
+			allocate(id) = _string;
+			shard.hashToID.emplace_hint(range.second, make_pair(h, id));
+		}
+	}
+
+	cached = CacheEntry{generation, h, id};
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	{
+		lock_guard<mutex> lock(g_resetCallbacksMutex);
+		for (auto const& cb: resetCallbacks())
+			cb();
+	}
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(g_resetCallbacksMutex);
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+void YulStringRepository::clear()
+{
+	for (auto& shard: m_shards)
+		shard.hashToID.clear();
+	for (auto& chunk: m_chunks)
+		delete[] chunk.exchange(nullptr, memory_order_relaxed);
+	allocate(0);
+	m_shards[emptyHash() >> (64 - shardBits)].hashToID.emplace(emptyHash(), 0);
+	m_nextID = 1;
+	++m_generation;
+}
+
+string& YulStringRepository::allocate(size_t _id)
+{
+	size_t chunkIndex = _id >> chunkBits;
+	yulAssert(chunkIndex < maxChunks, "Too many distinct Yul strings.");
+	string* chunk = m_chunks[chunkIndex].load(memory_order_acquire);
+	if (!chunk)
+	{
+		// Two threads can race for the allocation of a chunk if they insert into different shards.
+		auto newChunk = make_unique<string[]>(chunkSize);
+		if (m_chunks[chunkIndex].compare_exchange_strong(chunk, newChunk.get(), memory_order_acq_rel))
+			chunk = newChunk.release();
+	}
+	return chunk[_id & (chunkSize - 1)];
+}
+
+vector<function<void()>>& YulStringRepository::resetCallbacks()
+{
+	static vector<function<void()>> callbacks;
+	return callbacks;
+}
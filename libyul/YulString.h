@@ -23,11 +23,15 @@
 
 #include <boost/noncopyable.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
+#include <mutex>
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,6 +40,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Strings can be added and looked up concurrently from multiple threads: The hash table is split
+/// into shards that are locked independently and every thread keeps a small cache of the strings
+/// it has recently seen, which is consulted before taking any lock. The strings themselves are
+/// stored in chunks that are never moved, so looking up a string by its ID does not need a lock.
 class YulStringRepository
 {
 public:
@@ -51,26 +60,18 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	~YulStringRepository();
+
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		return m_chunks[_id >> chunkBits].load(std::memory_order_acquire)[_id & (chunkSize - 1)];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. Note that YulStrings are ordered by this hash, so changing it
+		// changes the order in which the optimiser visits names and thus its output.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -82,40 +83,49 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and no other
+	/// thread may use YulStrings at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Number of strings per storage chunk is 2**chunkBits.
+	static constexpr size_t chunkBits = 12;
+	static constexpr size_t chunkSize = size_t(1) << chunkBits;
+	static constexpr size_t maxChunks = size_t(1) << 15;
+	/// Number of independently locked parts of the hash table is 2**shardBits.
+	static constexpr size_t shardBits = 6;
+
+	struct alignas(64) Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
-	static std::vector<std::function<void()>>& resetCallbacks()
-	{
-		static std::vector<std::function<void()>> callbacks;
-		return callbacks;
-	}
+	/// Removes all strings but the empty string, which always has ID zero.
+	void clear();
+	/// @returns a reference to the (empty) storage for the string with the given ID,
+	/// allocating its chunk if needed.
+	std::string& allocate(size_t _id);
+
+	static std::vector<std::function<void()>>& resetCallbacks();
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<std::atomic<std::string*>, maxChunks> m_chunks{};
+	std::array<Shard, size_t(1) << shardBits> m_shards;
+	std::atomic<size_t> m_nextID{1};
+	/// Incremented on every reset to invalidate the per-thread caches.
+	std::atomic<std::uint64_t> m_generation{1};
 };
 
 /// Wrapper around handles into the YulString repository.
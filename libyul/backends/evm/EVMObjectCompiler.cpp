@@ -31,23 +31,25 @@
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(Object const& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
 {
 	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
 	compiler.run(_object, _optimize);
 }
 
-void EVMObjectCompiler::run(Object& _object, bool _optimize)
+void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 {
 	BuiltinContext context;
 	context.currentObject = &_object;
 
+	size_t subObjectCount = 0;
 	for (auto const& subNode: _object.subObjects)
-		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
 		{
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
+			// Object::pathToSubObject relies on this numbering.
+			yulAssert(subAssemblyAndID.second == subObjectCount++, "");
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
-			subObject->subId = subAssemblyAndID.second;
 			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
 		}
 		else
@@ -98,7 +98,7 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		message += ret.toString(&WasmDialect::instance());
 		message += "----------------------------------\n";
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, m_charStreamProvider);
 		yulAssert(false, message);
 	}
 
@@ -132,7 +132,7 @@ void EVMToEwasmTranslator::parsePolyfill()
 	{
 		string message;
 		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err);
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(*err, *scanner->charStream());
 		yulAssert(false, message);
 	}
 
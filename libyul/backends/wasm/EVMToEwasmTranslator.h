@@ -25,6 +25,8 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/Dialect.h>
 
+#include <liblangutil/CharStreamProvider.h>
+
 namespace solidity::yul
 {
 struct Object;
@@ -32,13 +34,19 @@ struct Object;
 class EVMToEwasmTranslator: public ASTModifier
 {
 public:
-	EVMToEwasmTranslator(Dialect const& _evmDialect): m_dialect(_evmDialect) {}
+	/// @param _charStreamProvider provides the sources of the translated code, used to
+	/// print errors in the translated code.
+	EVMToEwasmTranslator(Dialect const& _evmDialect, langutil::CharStreamProvider const& _charStreamProvider):
+		m_dialect(_evmDialect),
+		m_charStreamProvider(_charStreamProvider)
+	{}
 	Object run(Object const& _object);
 
 private:
 	void parsePolyfill();
 
 	Dialect const& m_dialect;
+	langutil::CharStreamProvider const& m_charStreamProvider;
 
 	std::shared_ptr<Block> m_polyfill;
 	std::set<YulString> m_polyfillFunctions;
@@ -24,6 +24,8 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 
+#include <mutex>
+
 using namespace std;
 using namespace solidity::yul;
 
@@ -167,6 +169,8 @@ WasmDialect const& WasmDialect::instance()
 {
 	static std::unique_ptr<WasmDialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -40,9 +40,10 @@ NameDispenser::NameDispenser(Dialect const& _dialect, Block const& _ast, set<Yul
 	m_reservedNames = move(_reservedNames);
 }
 
-NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames):
+NameDispenser::NameDispenser(Dialect const& _dialect, set<YulString> _usedNames, size_t _counter):
 	m_dialect(_dialect),
-	m_usedNames(std::move(_usedNames))
+	m_usedNames(std::move(_usedNames)),
+	m_counter(_counter)
 {
 }
 
@@ -41,8 +41,9 @@ class NameDispenser
 public:
 	/// Initialize the name dispenser with all the names used in the given AST.
 	explicit NameDispenser(Dialect const& _dialect, Block const& _ast, std::set<YulString> _reservedNames = {});
-	/// Initialize the name dispenser with the given used names.
-	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames);
+	/// Initialize the name dispenser with the given used names and the value of the counter
+	/// used to disambiguate new names.
+	explicit NameDispenser(Dialect const& _dialect, std::set<YulString> _usedNames, size_t _counter = 0);
 
 	/// @returns a currently unused name that should be similar to _nameHint.
 	YulString newName(YulString _nameHint);
@@ -51,7 +52,8 @@ public:
 	/// return it.
 	void markUsed(YulString _name) { m_usedNames.insert(_name); }
 
-	std::set<YulString> const& usedNames() { return m_usedNames; }
+	std::set<YulString> const& usedNames() const { return m_usedNames; }
+	size_t counter() const { return m_counter; }
 
 	/// Returns true if `_name` is either used or is a restricted identifier.
 	bool illegalName(YulString _name);
@@ -47,7 +47,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules keep the state of the current match, so every thread needs its own copy.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
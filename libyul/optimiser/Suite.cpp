@@ -71,6 +71,7 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TimeReport.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
@@ -171,40 +172,38 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -345,7 +344,10 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		{
+			util::TimeReport::Timer timer("Yul optimiser", step);
+			allSteps().at(step)->run(m_context, _ast);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
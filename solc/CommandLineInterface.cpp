@@ -53,9 +53,13 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/TimeReport.h>
 
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -124,6 +128,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -145,6 +150,7 @@ static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
 static string const g_strIROptimized = "ir-optimized";
 static string const g_strIPFS = "ipfs";
+static string const g_strJobs = "jobs";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
@@ -153,6 +159,7 @@ static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerEngine = "model-checker-engine";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNatspecDev = "devdoc";
@@ -180,6 +187,7 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
 static string const g_strSignatureHashes = "hashes";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
@@ -188,6 +196,7 @@ static string const g_strSrcMapRuntime = "srcmap-runtime";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strTimeReport = "time-report";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
@@ -225,6 +234,7 @@ static string const g_argMetadata = g_strMetadata;
 static string const g_argMetadataHash = g_strMetadataHash;
 static string const g_argMetadataLiteral = g_strMetadataLiteral;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
+static string const g_argModelCheckerRaceSolvers = g_strModelCheckerRaceSolvers;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
 static string const g_argNatspecDev = g_strNatspecDev;
@@ -233,6 +243,7 @@ static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
 static string const g_argOutputDir = g_strOutputDir;
+static string const g_argServer = g_strServer;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
@@ -534,6 +545,34 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contra
 	}
 }
 
+void CommandLineInterface::handleTimeReport()
+{
+	util::TimeReport const* timeReport = m_compiler->timeReport();
+	if (!timeReport)
+		return;
+
+	g_hasOutput = true;
+	sout() << endl << "======= Time report =======" << endl;
+	for (auto const& [scope, phases]: timeReport->scopes())
+	{
+		sout() << (scope.empty() ? "All sources" : scope) << ":" << endl;
+		vector<pair<string, util::TimeReport::Phase>> sortedPhases(phases.begin(), phases.end());
+		stable_sort(sortedPhases.begin(), sortedPhases.end(), [](auto const& _a, auto const& _b) {
+			return _a.second.time > _b.second.time;
+		});
+		for (auto const& [name, phase]: sortedPhases)
+		{
+			ostringstream line;
+			line << fixed << setprecision(3);
+			line << setw(12) << chrono::duration<double, milli>(phase.time).count() << " ms";
+			line << setw(8) << phase.calls << " calls";
+			if (util::countAllocations)
+				line << setw(12) << phase.allocations << " allocations";
+			sout() << line.str() << "  " << name << endl;
+		}
+	}
+}
+
 void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
 	Json::Value estimates = m_compiler->gasEstimates(_contract);
@@ -882,6 +921,25 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads during code generation and optimization and to check the verification targets "
+			"of the BMC model checking engine. Apart from the counterexamples found by the SMTChecker, "
+			"the output does not depend on this setting."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store the code generated for contracts in the given directory and reuse it as long as the contract, "
+			"the sources it imports and the settings are unchanged. Not used when generating IR. "
+			"Cannot be combined with --gas."
+		)
+		(
+			g_strTimeReport.c_str(),
+			"Print the time spent and the number of allocations made in each phase of the compilation, "
+			"per source and per contract."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -892,6 +950,12 @@ General Information)").c_str(),
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input, if no input file was given, otherwise it reads from the provided input file. The result will be written to standard output."
 		)
+		(
+			g_argServer.c_str(),
+			"Switch to Standard JSON server mode, ignoring all options. "
+			"Reads one Standard JSON input per line from standard input and writes each result as one line to standard output. "
+			"Sources of the previous input can be given by their \"keccak256\" hash alone and unchanged inputs are not recompiled."
+		)
 		(
 			g_argLink.c_str(),
 			("Switch to linker mode, ignoring all options apart from --" + g_argLibraries + " "
@@ -1070,6 +1134,11 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the SMT solvers concurrently in the BMC engine and use the first answer to each query. "
+			"By default, all solvers are queried one after the other and conflicting answers are reported."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1262,6 +1331,7 @@ bool CommandLineInterface::processInput()
 
 	vector<string> const exclusiveModes = {
 		g_argStandardJSON,
+		g_argServer,
 		g_argLink,
 		g_argAssemble,
 		g_argStrictAssembly,
@@ -1308,6 +1378,16 @@ bool CommandLineInterface::processInput()
 		return true;
 	}
 
+	if (m_args.count(g_argServer))
+	{
+		StandardCompiler compiler(fileReader);
+		compiler.enableArtifactCache();
+		for (string line; getline(cin, line);)
+			if (!boost::trim_copy(line).empty())
+				sout() << compiler.compile(line) << endl;
+		return true;
+	}
+
 	if (!readInputFilesAndConfigureRemappings())
 		return false;
 
@@ -1328,6 +1408,18 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
+	if (m_args.count(g_strJobs) && m_args[g_strJobs].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_strJobs << ": the number of threads must be positive." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_strCacheDir) && m_args.count(g_argGas))
+	{
+		serr() << "Option --" << g_strCacheDir << " cannot be combined with --" << g_argGas << "." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1497,9 +1589,11 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	m_modelCheckerSettings.raceSolvers = m_args.count(g_argModelCheckerRaceSolvers) > 0;
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
 
-	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+	SourceReferenceFormatter formatter(serr(false), *m_compiler, m_coloredOutput, m_withErrorIds);
 
 	try
 	{
@@ -1507,7 +1601,11 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerRaceSolvers)
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
@@ -1516,6 +1614,15 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		if (m_args.count(g_strJobs))
+			m_compiler->setParallelism(m_args[g_strJobs].as<unsigned>());
+		if (m_args.count(g_strCacheDir))
+			m_compiler->setBytecodeCacheDirectory(m_args[g_strCacheDir].as<string>());
+		if (m_args.count(g_strTimeReport))
+		{
+			m_compiler->setTimeReport(true);
+			util::countAllocations = true;
+		}
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
@@ -1772,7 +1879,7 @@ void CommandLineInterface::handleAst()
 
 bool CommandLineInterface::actOnInput()
 {
-	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
+	if (m_args.count(g_argStandardJSON) || m_args.count(g_argServer) || m_onlyAssemble)
 		// Already done in "processInput" phase.
 		return true;
 	else if (m_onlyLink)
@@ -1894,6 +2001,8 @@ bool CommandLineInterface::assemble(
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+		if (m_args.count(g_strJobs))
+			stack.setParallelism(m_args[g_strJobs].as<unsigned>());
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -1924,7 +2033,7 @@ bool CommandLineInterface::assemble(
 	for (auto const& sourceAndStack: assemblyStacks)
 	{
 		auto const& stack = sourceAndStack.second;
-		SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
+		SourceReferenceFormatter formatter(serr(false), stack, m_coloredOutput, m_withErrorIds);
 
 		for (auto const& error: stack.errors())
 		{
@@ -2034,6 +2143,7 @@ void CommandLineInterface::outputCompilationResults()
 		m_stopAfter == CompilerStack::State::CompilationSuccessful
 	)
 	{
+		handleTimeReport();
 		serr() << endl << "Compilation halted after AST generation due to errors." << endl;
 		return;
 	}
@@ -2078,6 +2188,8 @@ void CommandLineInterface::outputCompilationResults()
 		handleNatspec(false, contract);
 	} // end of contracts iteration
 
+	handleTimeReport();
+
 	if (!g_hasOutput)
 	{
 		if (m_args.count(g_argOutputDir))
@@ -22,12 +22,90 @@
  */
 
 #include <solc/CommandLineInterface.h>
+#include <libsolutil/TimeReport.h>
 #include <boost/exception/all.hpp>
 #include <clocale>
+#include <cstdlib>
 #include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 using namespace std;
 
+// Count the allocations for --time-report. The array and nothrow forms of the operators
+// forward to these ones by default.
+static void* allocate(size_t _size, size_t _alignment)
+{
+	if (solidity::util::countAllocations.load(memory_order_relaxed))
+		++solidity::util::allocationCount;
+	if (_size == 0)
+		_size = 1;
+	while (true)
+	{
+		void* memory = nullptr;
+		if (_alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+			memory = malloc(_size);
+		else
+#ifdef _WIN32
+			memory = _aligned_malloc(_size, _alignment);
+#else
+			// The size has to be a multiple of the alignment.
+			memory = aligned_alloc(_alignment, (_size + _alignment - 1) / _alignment * _alignment);
+#endif
+		if (memory)
+			return memory;
+		if (new_handler handler = get_new_handler())
+			handler();
+		else
+			throw bad_alloc();
+	}
+}
+
+static void deallocateAligned(void* _memory)
+{
+#ifdef _WIN32
+	_aligned_free(_memory);
+#else
+	free(_memory);
+#endif
+}
+
+void* operator new(size_t _size)
+{
+	return allocate(_size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t _size, align_val_t _alignment)
+{
+	return allocate(_size, static_cast<size_t>(_alignment));
+}
+
+void operator delete(void* _memory) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, size_t) noexcept
+{
+	free(_memory);
+}
+
+void operator delete(void* _memory, align_val_t _alignment) noexcept
+{
+	if (static_cast<size_t>(_alignment) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		free(_memory);
+	else
+		deallocateAligned(_memory);
+}
+
+void operator delete(void* _memory, size_t, align_val_t _alignment) noexcept
+{
+	operator delete(_memory, _alignment);
+}
+
 /*
 The equivalent of setlocale(LC_ALL, "C") is called before any user code is run.
 If the user has an invalid environment setting then it is possible for the call
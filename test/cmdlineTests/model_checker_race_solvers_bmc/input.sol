@@ -0,0 +1,8 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+pragma experimental SMTChecker;
+contract test {
+    function f(uint x) public pure {
+		assert(x > 0);
+    }
+}
\ No newline at end of file
@@ -931,6 +931,44 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_loops_across_tags)
+{
+	// The compared suffixes continue after JUMPI and across tags. Pushes of the block's own tag
+	// are unified there as well, while pushes of other tags are not.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(7),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 3),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(7),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 4),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 5),
+		u256(7),
+		AssemblyItem(PushTag, 5),
+		Instruction::JUMPI,
+		AssemblyItem(Tag, 6),
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP,
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+
+	map<u256, u256> expectation{{2, 1}, {4, 3}, {6, 3}};
+	BOOST_CHECK(deduplicator.replacedTags() == expectation);
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1255,6 +1293,55 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies_parallel)
+{
+	// This tests that sub-assemblies optimised concurrently keep
+	// the tags referenced by the super-assembly.
+
+	Assembly main;
+	vector<AssemblyPointer> subs;
+	vector<AssemblyItem> subTags;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		AssemblyPointer sub = make_shared<Assembly>();
+		auto t1 = sub->newTag();
+		sub->append(t1);
+		sub->append(u256(i));
+		sub->append(Instruction::JUMP);
+		auto t2 = sub->newTag();
+		sub->append(t2); // This will be removed
+		sub->append(u256(i));
+		sub->append(Instruction::JUMP);
+
+		size_t subId = static_cast<size_t>(main.appendSubroutine(sub).data());
+		main.append(t1.toSubAssemblyTag(subId));
+		subs.emplace_back(sub);
+		subTags.emplace_back(t1.toSubAssemblyTag(subId));
+	}
+
+	Assembly::OptimiserSettings settings;
+	settings.isCreation = true;
+	settings.runJumpdestRemover = true;
+	settings.runPeephole = true;
+	settings.runDeduplicate = true;
+	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	settings.parallelism = 4;
+	main.optimise(settings);
+
+	AssemblyItems expectationMain;
+	for (size_t i = 0; i < subs.size(); ++i)
+	{
+		expectationMain.emplace_back(PushSubSize, i);
+		expectationMain.emplace_back(subTags[i].pushTag());
+	}
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		main.items().begin(), main.items().end(),
+		expectationMain.begin(), expectationMain.end()
+	);
+	for (size_t i = 0; i < subs.size(); ++i)
+		BOOST_CHECK_EQUAL(subs[i]->items().size(), size_t(3));
+}
+
 BOOST_AUTO_TEST_CASE(cse_sub_zero)
 {
 	checkCSE({
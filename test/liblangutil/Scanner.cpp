@@ -526,6 +526,31 @@ BOOST_AUTO_TEST_CASE(empty_multiline_documentation_comment_before_eos)
 	BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), "");
 }
 
+BOOST_AUTO_TEST_CASE(long_whitespace_comments_and_identifiers)
+{
+	string identifier = "_$a" + string(1000, 'x') + "09";
+	string source =
+		string(1000, ' ') + "\t\r\n" + identifier +
+		"/* " + string(1000, '*') + " */" +
+		"// " + string(1000, '/') + "\n" +
+		"0x" + string(1000, 'f') + string(1000, ' ');
+	Scanner scanner(CharStream(source, ""));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 1003);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Number);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "0x" + string(1000, 'f'));
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(unterminated_long_multiline_comment)
+{
+	Scanner scanner(CharStream("/* " + string(1000, '*'), ""));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalCommentTerminator);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_CASE(comments_mixed_in_sequence)
 {
 	Scanner scanner(CharStream("hello_world ///documentation comment \n"
@@ -34,9 +34,9 @@ BOOST_AUTO_TEST_SUITE(SourceLocationTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
 {
-	auto const source = std::make_shared<CharStream>("lorem ipsum", "source");
-	auto const sourceA = std::make_shared<CharStream>("lorem ipsum", "sourceA");
-	auto const sourceB = std::make_shared<CharStream>("lorem ipsum", "sourceB");
+	auto const source = internSourceName("source");
+	auto const sourceA = internSourceName("sourceA");
+	auto const sourceB = internSourceName("sourceB");
 
 	BOOST_CHECK(SourceLocation{} == SourceLocation{});
 	BOOST_CHECK((SourceLocation{0, 3, sourceA} != SourceLocation{0, 3, sourceB}));
@@ -46,6 +46,37 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(interned_names)
+{
+	std::string const name = "source";
+	BOOST_CHECK(internSourceName("source") == internSourceName(name));
+	BOOST_CHECK(internSourceName("source") != internSourceName("sourceA"));
+	BOOST_CHECK_EQUAL(*internSourceName(name), name);
+	BOOST_CHECK((SourceLocation{0, 3, internSourceName("source")} == SourceLocation{0, 3, internSourceName(name)}));
+}
+
+BOOST_AUTO_TEST_CASE(scoped_name_repositories)
+{
+	std::string const* outer = internSourceName("source");
+	SourceNameRepository repository;
+	{
+		SourceNameRepository::Scope scope(repository);
+		std::string const* inner = internSourceName("source");
+		BOOST_CHECK(inner != outer);
+		BOOST_CHECK_EQUAL(*inner, *outer);
+		BOOST_CHECK(inner == repository.intern("source"));
+		BOOST_CHECK((SourceLocation{0, 3, inner} != SourceLocation{0, 3, outer}));
+
+		SourceNameRepository nestedRepository;
+		{
+			SourceNameRepository::Scope nestedScope(nestedRepository);
+			BOOST_CHECK(internSourceName("source") != inner);
+		}
+		BOOST_CHECK(internSourceName("source") == inner);
+	}
+	BOOST_CHECK(internSourceName("source") == outer);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -141,7 +141,7 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 
 	if (!c.compile(CompilerStack::State::Parsed))
 	{
-		SourceReferenceFormatter formatter(_stream, _formatted, false);
+		SourceReferenceFormatter formatter(_stream, c, _formatted, false);
 		for (auto const& error: c.errors())
 			formatter.printErrorInformation(*error);
 		return TestResult::FatalError;
@@ -167,7 +167,7 @@ TestCase::TestResult ASTJSONTest::run(ostream& _stream, string const& _linePrefi
 		if (m_expectation.empty())
 			return resultsMatch ? TestResult::Success : TestResult::Failure;
 
-		SourceReferenceFormatter formatter(_stream, _formatted, false);
+		SourceReferenceFormatter formatter(_stream, c, _formatted, false);
 		for (auto const& error: c.errors())
 			formatter.printErrorInformation(*error);
 		return TestResult::FatalError;
@@ -0,0 +1,197 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the on-disk cache of generated code.
+ */
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+class TemporaryDirectory
+{
+public:
+	TemporaryDirectory():
+		m_path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solc-bytecode-cache-%%%%-%%%%-%%%%"))
+	{
+		boost::filesystem::create_directories(m_path);
+	}
+	~TemporaryDirectory()
+	{
+		boost::system::error_code error;
+		boost::filesystem::remove_all(m_path, error);
+	}
+
+	string path() const { return m_path.string(); }
+	size_t entries() const
+	{
+		return static_cast<size_t>(distance(
+			boost::filesystem::directory_iterator(m_path),
+			boost::filesystem::directory_iterator()
+		));
+	}
+
+private:
+	boost::filesystem::path m_path;
+};
+
+StringMap const sources{
+	{"A.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L { function f(uint x) public pure returns (uint) { return x * 7; } }
+		struct S { uint a; bytes b; }
+		contract A {
+			uint immutable x = block.number;
+			function g(S memory s) public view returns (uint) { return L.f(s.a) + x; }
+		}
+	)"},
+	{"B.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		import "A.sol";
+		contract B {
+			function create() public returns (A) { return new A(); }
+			function code() public pure returns (bytes memory) { return type(A).creationCode; }
+		}
+		abstract contract D { function h() public virtual returns (B) { return new B(); } }
+	)"},
+	{"C.sol", R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C { event E(string); function f(string calldata s) external { emit E(s); } }
+	)"}
+};
+
+/// @returns all outputs of @a _stack that can be loaded from the cache, in a comparable form.
+map<string, string> outputs(CompilerStack const& _stack, StringMap const& _sources)
+{
+	map<string, string> ret;
+	auto linkerObject = [](evmasm::LinkerObject const& _object)
+	{
+		string output = _object.toHex();
+		for (auto const& [offset, library]: _object.linkReferences)
+			output += " " + to_string(offset) + ":" + library;
+		for (auto const& [hash, reference]: _object.immutableReferences)
+		{
+			output += " " + reference.first;
+			for (size_t offset: reference.second)
+				output += ":" + to_string(offset);
+		}
+		return output;
+	};
+	for (string const& name: _stack.contractNames())
+	{
+		ret[name + " object"] = linkerObject(_stack.object(name));
+		ret[name + " runtimeObject"] = linkerObject(_stack.runtimeObject(name));
+		ret[name + " assembly"] = _stack.assemblyString(name, _sources);
+		ret[name + " assemblyJSON"] = util::jsonCompactPrint(_stack.assemblyJSON(name));
+		ret[name + " sourceMapping"] = _stack.sourceMapping(name) ? *_stack.sourceMapping(name) : "";
+		ret[name + " runtimeSourceMapping"] = _stack.runtimeSourceMapping(name) ? *_stack.runtimeSourceMapping(name) : "";
+		ret[name + " generatedSources"] = util::jsonCompactPrint(_stack.generatedSources(name, false));
+		ret[name + " runtimeGeneratedSources"] = util::jsonCompactPrint(_stack.generatedSources(name, true));
+		ret[name + " metadata"] = _stack.metadata(name);
+	}
+	return ret;
+}
+
+map<string, string> compile(StringMap const& _sources, string const& _cacheDirectory, set<string>* _cachedContracts = nullptr)
+{
+	CompilerStack stack;
+	stack.setSources(_sources);
+	stack.setOptimiserSettings(OptimiserSettings::standard());
+	stack.setLibraries({{"A.sol:L", util::h160(0x1234)}});
+	stack.setBytecodeCacheDirectory(_cacheDirectory);
+	BOOST_REQUIRE(stack.compile());
+	if (_cachedContracts)
+		for (string const& name: stack.contractNames())
+			// Contracts loaded from the cache have no assembly.
+			if (!stack.assemblyItems(name) && !stack.object(name).bytecode.empty())
+				_cachedContracts->insert(name);
+	return outputs(stack, _sources);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityBytecodeCache)
+
+BOOST_AUTO_TEST_CASE(cached_output_equals_fresh_output)
+{
+	TemporaryDirectory cacheDirectory;
+	map<string, string> fresh = compile(sources, "");
+
+	set<string> cachedContracts;
+	BOOST_CHECK(compile(sources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK(cachedContracts.empty());
+	// One entry for L, one for A and B, which depend on each other, and one for C.
+	BOOST_CHECK_EQUAL(cacheDirectory.entries(), 3);
+
+	BOOST_CHECK(compile(sources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK(cachedContracts == (set<string>{"A.sol:L", "A.sol:A", "B.sol:B", "C.sol:C"}));
+	BOOST_CHECK_EQUAL(cacheDirectory.entries(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(changed_import_invalidates_entries)
+{
+	TemporaryDirectory cacheDirectory;
+	compile(sources, cacheDirectory.path());
+
+	StringMap changedSources = sources;
+	changedSources["B.sol"] += "contract E {}";
+	map<string, string> fresh = compile(changedSources, "");
+
+	// B has to be generated again together with A. C does not import B.sol, but its AST IDs
+	// follow those of B.sol, so it is not taken from the cache either.
+	set<string> cachedContracts;
+	BOOST_CHECK(compile(changedSources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK(cachedContracts == (set<string>{"A.sol:L"}));
+
+	changedSources["A.sol"] += "contract F {}";
+	fresh = compile(changedSources, "");
+	cachedContracts.clear();
+	BOOST_CHECK(compile(changedSources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK(cachedContracts.empty());
+}
+
+BOOST_AUTO_TEST_CASE(corrupted_entry)
+{
+	TemporaryDirectory cacheDirectory;
+	map<string, string> fresh = compile(sources, cacheDirectory.path());
+	for (auto const& entry: boost::filesystem::directory_iterator(cacheDirectory.path()))
+		boost::filesystem::resize_file(entry.path(), 10);
+
+	set<string> cachedContracts;
+	BOOST_CHECK(compile(sources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK(cachedContracts.empty());
+	BOOST_CHECK(compile(sources, cacheDirectory.path(), &cachedContracts) == fresh);
+	BOOST_CHECK_EQUAL(cachedContracts.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
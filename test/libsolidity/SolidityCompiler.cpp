@@ -22,8 +22,19 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/YulString.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace std;
 
 namespace solidity::frontend::test
@@ -51,6 +62,194 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(cached_yul_utility_code)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function f(uint[] memory a, string calldata s) public pure returns (bytes memory) {
+				return abi.encode(a, s);
+			}
+		}
+	)";
+	auto compile = [&](OptimiserSettings const& _optimiserSettings)
+	{
+		CompilerStack stack;
+		stack.setSources({{"", sourceCode}});
+		stack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		stack.setOptimiserSettings(_optimiserSettings);
+		BOOST_REQUIRE_MESSAGE(stack.compile(), "Compiling contract failed");
+		return make_pair(stack.object("C").bytecode, stack.runtimeObject("C").bytecode);
+	};
+
+	for (OptimiserSettings const& optimiserSettings: {OptimiserSettings::minimal(), OptimiserSettings::standard()})
+	{
+		// Resetting the repository also clears the cache of the Yul utility code.
+		yul::YulStringRepository::reset();
+		auto uncached = compile(optimiserSettings);
+		auto cached = compile(optimiserSettings);
+		BOOST_CHECK(cached.first == uncached.first);
+		BOOST_CHECK(cached.second == uncached.second);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compiler_stack_used_from_several_threads)
+{
+	char const* sourceCode = R"(
+		contract C {
+			struct S { uint[] a; bytes b; }
+			mapping(address => S) m;
+			function f(S memory s) public returns (bytes32, int16[3] memory) {}
+			function g(bytes4 x) public pure returns (int8, address payable) {}
+		}
+	)";
+	auto prepare = [&](CompilerStack& _stack)
+	{
+		_stack.setSources({{"", sourceCode}});
+		_stack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	};
+
+	CompilerStack reference;
+	prepare(reference);
+	BOOST_REQUIRE_MESSAGE(reference.compile(), "Compiling contract failed");
+
+	auto stack = make_unique<CompilerStack>();
+	prepare(*stack);
+	bool analyzed = false;
+	thread([&]() { analyzed = stack->parseAndAnalyze(); }).join();
+	BOOST_REQUIRE(analyzed);
+
+	// Another stack on this thread must neither use nor release the types of the first one.
+	{
+		CompilerStack other;
+		prepare(other);
+		BOOST_REQUIRE(other.compile());
+		other.reset();
+	}
+
+	bool compiled = false;
+	thread([&]() { compiled = stack->compile(); }).join();
+	BOOST_REQUIRE(compiled);
+	BOOST_CHECK(stack->contractABI("C") == reference.contractABI("C"));
+	BOOST_CHECK(stack->object("C").bytecode == reference.object("C").bytecode);
+	thread([&]() { stack.reset(); }).join();
+
+	BOOST_CHECK(reference.methodIdentifiers("C").isMember("g(bytes4)"));
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_matches_text_round_trip)
+{
+	// The code of the contracts created by other contracts is shared between the
+	// objects of their creators, so it is embedded at several places.
+	char const* sourceCode = R"(
+		contract D {
+			uint public x;
+			constructor(uint _x) { x = _x; }
+			function f() public view returns (uint) { return x * 2; }
+		}
+		contract E {
+			function make(uint _x) public returns (D) { return new D(_x); }
+		}
+		contract A {
+			function f() public returns (D) { return new D(2); }
+			function g() public returns (E) { new D(3); return new E(); }
+		}
+		contract B {
+			function h() public pure returns (bytes memory) { return type(E).creationCode; }
+		}
+	)";
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	OptimiserSettings minimalWithYul = OptimiserSettings::minimal();
+	minimalWithYul.runYulOptimiser = true;
+	minimalWithYul.yulOptimiserSteps = "uljmul jmul";
+	for (OptimiserSettings const& settings: {OptimiserSettings::minimal(), minimalWithYul, OptimiserSettings::standard()})
+	{
+		CompilerStack stack;
+		stack.setSources({{"", sourceCode}});
+		stack.setEVMVersion(evmVersion);
+		stack.setViaIR(true);
+		stack.enableIRGeneration(true);
+		stack.setOptimiserSettings(settings);
+		BOOST_REQUIRE_MESSAGE(stack.compile(), "Compiling contract failed");
+
+		for (string const& name: stack.contractNames())
+		{
+			// This is how the code used to be generated: the IR is optimized, printed,
+			// parsed and optimized once more before it is assembled.
+			yul::AssemblyStack optimizedStack(evmVersion, yul::AssemblyStack::Language::StrictAssembly, settings);
+			BOOST_REQUIRE(optimizedStack.parseAndAnalyze("", stack.yulIR(name)));
+			optimizedStack.optimize();
+			string const optimizedIR = optimizedStack.print();
+			BOOST_CHECK(boost::ends_with(stack.yulIROptimized(name), optimizedIR));
+
+			yul::AssemblyStack evmStack(evmVersion, yul::AssemblyStack::Language::StrictAssembly, settings);
+			BOOST_REQUIRE(evmStack.parseAndAnalyze("", optimizedIR));
+			evmStack.optimize();
+			yul::MachineAssemblyObject object = evmStack.assemble(yul::AssemblyStack::Machine::EVM);
+			BOOST_REQUIRE(object.bytecode);
+			BOOST_CHECK_EQUAL(object.bytecode->toHex(), stack.object(name).toHex());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_created_contract_embedded_identically)
+{
+	char const* sourceCode = R"(
+		contract D {
+			uint public x;
+			constructor(uint _x) { x = _x; }
+		}
+		contract E {
+			function make() public returns (D) { return new D(1); }
+		}
+		contract A {
+			function f() public returns (D) { return new D(2); }
+		}
+		contract B {
+			function g() public returns (D) { return new D(3); }
+		}
+		contract C {
+			function h() public returns (E) { return new E(); }
+		}
+	)";
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	CompilerStack stack;
+	stack.setSources({{"", sourceCode}});
+	stack.setEVMVersion(evmVersion);
+	stack.setViaIR(true);
+	stack.enableIRGeneration(true);
+	stack.setOptimiserSettings(OptimiserSettings::standard());
+	BOOST_REQUIRE_MESSAGE(stack.compile(), "Compiling contract failed");
+
+	// Collects the bytecode of all objects of D embedded into the optimized IR of a contract.
+	yul::Dialect const& dialect = yul::EVMDialect::strictAssemblyForEVMObjects(evmVersion);
+	vector<string> embeddedBytecodes;
+	std::function<void(yul::Object const&)> collect = [&](yul::Object const& _object)
+	{
+		for (auto const& subNode: _object.subObjects)
+			if (auto const* subObject = dynamic_cast<yul::Object const*>(subNode.get()))
+			{
+				if (boost::starts_with(subObject->name.str(), "D_") && !boost::ends_with(subObject->name.str(), "_deployed"))
+				{
+					yul::AssemblyStack objectStack(evmVersion, yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::standard());
+					BOOST_REQUIRE(objectStack.parseAndAnalyze("", subObject->toString(&dialect)));
+					embeddedBytecodes.emplace_back(objectStack.assemble(yul::AssemblyStack::Machine::EVM).bytecode->toHex());
+				}
+				collect(*subObject);
+			}
+	};
+	for (char const* name: {"A", "B", "C"})
+	{
+		yul::AssemblyStack creatorStack(evmVersion, yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::standard());
+		BOOST_REQUIRE(creatorStack.parseAndAnalyze("", stack.yulIROptimized(name)));
+		collect(*creatorStack.parserResult());
+	}
+
+	// A and B create D directly, C through E.
+	BOOST_REQUIRE_EQUAL(embeddedBytecodes.size(), 3);
+	for (string const& bytecode: embeddedBytecodes)
+		BOOST_CHECK_EQUAL(bytecode, embeddedBytecodes.front());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
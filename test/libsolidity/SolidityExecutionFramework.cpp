@@ -62,7 +62,7 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 			for (auto const& error: m_compiler.errors())
 				if (error->type() == langutil::Error::Type::CodeGenerationError)
 					BOOST_THROW_EXCEPTION(*error);
-		langutil::SourceReferenceFormatter formatter(std::cerr, true, false);
+		langutil::SourceReferenceFormatter formatter(std::cerr, m_compiler, true, false);
 
 		for (auto const& error: m_compiler.errors())
 			formatter.printErrorInformation(*error);
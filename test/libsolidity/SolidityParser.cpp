@@ -591,19 +591,21 @@ BOOST_AUTO_TEST_CASE(inline_asm_end_location)
 	class CheckInlineAsmLocation: public ASTConstVisitor
 	{
 	public:
+		explicit CheckInlineAsmLocation(string _sourceCode): m_charStream(std::move(_sourceCode), "") {}
 		bool visited = false;
 		bool visit(InlineAssembly const& _inlineAsm) override
 		{
-			auto loc = _inlineAsm.location();
-			auto asmStr = loc.source->source().substr(static_cast<size_t>(loc.start), static_cast<size_t>(loc.end - loc.start));
+			auto asmStr = m_charStream.text(_inlineAsm.location());
 			BOOST_CHECK_EQUAL(asmStr, "assembly { a := 0x12345678 }");
 			visited = true;
 
 			return false;
 		}
+	private:
+		CharStream m_charStream;
 	};
 
-	CheckInlineAsmLocation visitor;
+	CheckInlineAsmLocation visitor{sourceCode};
 	contract->accept(visitor);
 
 	BOOST_CHECK_MESSAGE(visitor.visited, "No inline asm block found?!");
@@ -27,10 +27,12 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
 #include <set>
+#include <thread>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1755,6 +1757,225 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(parallelism_invalid_value)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"parallelism": 0,
+			"outputSelection":
+			{
+				"*": { "C": ["evm.bytecode"] }
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallelism_output_equal)
+{
+	string const sources = R"(
+		"A.sol": {
+			"content": "pragma solidity >=0.0; contract A { uint x; function f() public { x++; } } contract B { function g() public returns (A) { return new A(); } }"
+		},
+		"C.sol": {
+			"content": "pragma solidity >=0.0; import \"A.sol\"; contract C { function h() public returns (B) { return new B(); } } contract D { function k() public pure returns (uint) { return 7; } } contract E is D {}"
+		}
+	)";
+	auto input = [&](unsigned _parallelism, bool _viaIR)
+	{
+		return
+			"{\"language\": \"Solidity\", \"sources\": {" + sources + "}, \"settings\": {"
+			"\"parallelism\": " + to_string(_parallelism) + ", \"optimizer\": { \"enabled\": true }, "
+			"\"viaIR\": " + (_viaIR ? "true" : "false") + ", "
+			"\"outputSelection\": { \"*\": { \"*\": [\"evm.bytecode\", \"evm.deployedBytecode\", \"evm.assembly\", \"irOptimized\", \"metadata\"] } }"
+			"}}";
+	};
+
+	for (bool viaIR: {false, true})
+	{
+		Json::Value serialResult = compile(input(1, viaIR));
+		BOOST_REQUIRE(containsAtMostWarnings(serialResult));
+		BOOST_REQUIRE(getContractResult(serialResult, "C.sol", "C").isObject());
+		for (unsigned parallelism: {2u, 4u, 16u})
+			BOOST_CHECK(compile(input(parallelism, viaIR)) == serialResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(time_report)
+{
+	auto input = [](string const& _timeReport)
+	{
+		return R"(
+		{
+			"language": "Solidity",
+			"sources":
+			{ "A.sol": { "content": "pragma solidity >=0.0; contract C { function f(uint[] calldata x) public pure returns (uint) { return x[1]; } }" } },
+			"settings":
+			{
+				"timeReport": )" + _timeReport + R"(,
+				"optimizer": { "enabled": true },
+				"outputSelection":
+				{
+					"*": { "C": ["evm.bytecode"] }
+				}
+			}
+		}
+		)";
+	};
+
+	Json::Value result = compile(input("\"yes\""));
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.timeReport\" must be a Boolean."));
+
+	result = compile(input("false"));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("timeReport"));
+
+	result = compile(input("true"));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json::Value const& timeReport = result["timeReport"];
+	BOOST_REQUIRE(timeReport.isObject());
+	BOOST_CHECK(timeReport["A.sol"].isMember("parsing"));
+	BOOST_CHECK(timeReport["A.sol"].isMember("analysis: TypeChecker"));
+	BOOST_CHECK(timeReport["A.sol:C"].isMember("code generation: ContractCompiler"));
+	BOOST_CHECK(timeReport["A.sol:C"].isMember("Yul optimiser: ExpressionSimplifier"));
+	BOOST_CHECK(timeReport["A.sol:C"].isMember("EVM optimiser: PeepholeOptimiser"));
+	BOOST_CHECK(timeReport["A.sol:C"].isMember("EVM assembly"));
+	for (string const& scope: timeReport.getMemberNames())
+		for (string const& phase: timeReport[scope].getMemberNames())
+			BOOST_CHECK(timeReport[scope][phase]["calls"].asUInt64() > 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_analysis)
+{
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; struct S { uint[] a; bytes b; } contract A { mapping(address => S) m; event E(uint8 indexed, string); function f(S memory s) public returns (bytes32, int16[3] memory) { emit E(1, \"x\"); } }"
+			},
+			"B.sol": {
+				"content": "pragma solidity >=0.0; import \"A.sol\"; contract B is A { function g(bytes4 x) public pure returns (int8, address payable) {} }"
+			}
+		},
+		"settings": {
+			"outputSelection": { "*": { "*": ["abi", "evm.methodIdentifiers"], "": ["ast"] } }
+		}
+	}
+	)";
+
+	string const serialResult = frontend::StandardCompiler{}.compile(input);
+	vector<string> results(4);
+	vector<thread> threads;
+	for (size_t i = 0; i < results.size(); ++i)
+		threads.emplace_back([&, i]() {
+			for (size_t run = 0; run < 5; ++run)
+				results[i] = frontend::StandardCompiler{}.compile(input);
+		});
+	for (auto& t: threads)
+		t.join();
+
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(serialResult, result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_REQUIRE(getContractResult(result, "B.sol", "B").isObject());
+	for (string const& concurrentResult: results)
+		BOOST_CHECK(concurrentResult == serialResult);
+}
+
+BOOST_AUTO_TEST_CASE(artifact_cache_sources_by_hash)
+{
+	string const content = "pragma solidity >=0.0; contract C { function f() public pure {} }";
+	string const hash = "0x" + util::keccak256(content).hex();
+	auto input = [&](string const& _source)
+	{
+		return
+			"{\"language\": \"Solidity\", \"sources\": {\"A.sol\": " + _source + "}, "
+			"\"settings\": {\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\"]}}}}";
+	};
+	string const withContent = input("{\"content\": \"" + content + "\"}");
+	string const byHash = input("{\"keccak256\": \"" + hash + "\"}");
+
+	frontend::StandardCompiler compiler;
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(byHash), result));
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid input source specified."));
+
+	compiler.enableArtifactCache();
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(byHash), result));
+	BOOST_CHECK(containsError(result, "JSONError", "No content given for \"A.sol\" and its hash is not in the cache."));
+
+	Json::Value expectation = compile(withContent);
+	BOOST_REQUIRE(containsAtMostWarnings(expectation));
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(withContent), result));
+	BOOST_CHECK(result == expectation);
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(byHash), result));
+	BOOST_CHECK(result == expectation);
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(withContent), result));
+	BOOST_CHECK(result == expectation);
+}
+
+BOOST_AUTO_TEST_CASE(artifact_cache_keeps_sources_of_time_reports)
+{
+	string const content = "pragma solidity >=0.0; contract C { function f() public pure {} }";
+	string const hash = "0x" + util::keccak256(content).hex();
+	auto input = [&](string const& _source, bool _timeReport)
+	{
+		return
+			"{\"language\": \"Solidity\", \"sources\": {\"A.sol\": " + _source + "}, "
+			"\"settings\": {" + (_timeReport ? "\"timeReport\": true, " : "") +
+			"\"outputSelection\": {\"*\": {\"*\": [\"evm.bytecode.object\"]}}}}";
+	};
+
+	frontend::StandardCompiler compiler;
+	compiler.enableArtifactCache();
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input("{\"content\": \"" + content + "\"}", true)), result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result.isMember("timeReport"));
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input("{\"keccak256\": \"" + hash + "\"}", true)), result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK(result.isMember("timeReport"));
+	BOOST_CHECK(getContractResult(result, "A.sol", "C").isObject());
+}
+
+BOOST_AUTO_TEST_CASE(artifact_cache_revalidates_imports)
+{
+	map<string, string> files{{"B.sol", "pragma solidity >=0.0; contract B { function f() public pure returns (uint) { return 1; } }"}};
+	ReadCallback::Callback reader = [&](string const&, string const& _path)
+	{
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "File not found."};
+	};
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "pragma solidity >=0.0; import \"B.sol\"; contract A is B {}" } },
+		"settings": { "outputSelection": { "*": { "*": ["abi"] } } }
+	}
+	)";
+
+	frontend::StandardCompiler compiler(reader);
+	compiler.enableArtifactCache();
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["A"]["abi"][0]["name"].asString(), "f");
+
+	files["B.sol"] = "pragma solidity >=0.0; contract B { function g() public pure returns (uint) { return 2; } }";
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["A"]["abi"][0]["name"].asString(), "g");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
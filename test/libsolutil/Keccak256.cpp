@@ -69,6 +69,57 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(multiple_inputs)
+{
+	BOOST_CHECK(keccak256(vector<bytesConstRef>{}).empty());
+
+	vector<string> inputs{"", "test", "longer test string", "test", ""};
+	// Inputs of different lengths around multiples of the rate of 136 bytes, several of each
+	// length so that some of them are hashed at the same time.
+	for (size_t length: vector<size_t>{31, 32, 135, 136, 137, 271, 272, 1000})
+		for (char c: string("abcdefghi"))
+			inputs.emplace_back(length, c);
+
+	vector<h256> hashes = keccak256(inputs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+	BOOST_CHECK_EQUAL(
+		hashes[1],
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	BOOST_CHECK_EQUAL(IncrementalKeccak256{}.digest(), keccak256(bytes()));
+
+	string input;
+	for (size_t i = 0; i < 1000; ++i)
+		input += static_cast<char>('a' + i % 26);
+	// Pieces that end before, at and after the block boundaries of 136 bytes.
+	for (size_t pieceLength: vector<size_t>{1, 7, 135, 136, 137, 300})
+	{
+		IncrementalKeccak256 hash;
+		for (size_t offset = 0; offset < input.size(); offset += pieceLength)
+		{
+			string piece = input.substr(offset, pieceLength);
+			IncrementalKeccak256 copy = hash;
+			hash.absorb(piece);
+			BOOST_CHECK_EQUAL(hash.digest(), keccak256(input.substr(0, offset + piece.size())));
+			// The copy is not affected by absorbing into the original.
+			BOOST_CHECK_EQUAL(copy.digest(), keccak256(input.substr(0, offset)));
+		}
+	}
+	IncrementalKeccak256 hash;
+	hash.absorb("longer ");
+	hash.absorb("test string");
+	BOOST_CHECK_EQUAL(
+		hash.digest(),
+		FixedHash<32>("0x47bed17bfbbc08d6b5a0f603eff1b3e932c37c10b865847a7bc73d55b260f32a")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
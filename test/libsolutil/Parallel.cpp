@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for parallelFor.
+ */
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest)
+
+BOOST_AUTO_TEST_CASE(all_jobs_run_once)
+{
+	for (unsigned parallelism: {1u, 2u, 7u, 100u})
+	{
+		vector<atomic<unsigned>> calls(50);
+		parallelFor(calls.size(), parallelism, [&](size_t _index) { ++calls[_index]; });
+		for (auto const& count: calls)
+			BOOST_CHECK_EQUAL(count.load(), 1u);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(no_jobs)
+{
+	parallelFor(0, 4, [](size_t) { BOOST_FAIL("Unexpected call."); });
+}
+
+BOOST_AUTO_TEST_CASE(nested_calls)
+{
+	vector<atomic<unsigned>> calls(64);
+	parallelFor(8, 4, [&](size_t _outer) {
+		parallelFor(8, 4, [&](size_t _inner) { ++calls[_outer * 8 + _inner]; });
+	});
+	for (auto const& count: calls)
+		BOOST_CHECK_EQUAL(count.load(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(threads_are_reused)
+{
+	size_t const noCall = numeric_limits<size_t>::max();
+	static thread_local size_t lastCall = noCall;
+	thread::id const caller = this_thread::get_id();
+	atomic<bool> reused{false};
+	for (size_t call = 0; call < 20 && !reused; ++call)
+		parallelFor(8, 4, [&](size_t) {
+			if (this_thread::get_id() != caller && lastCall != noCall && lastCall != call)
+				reused = true;
+			lastCall = call;
+			this_thread::sleep_for(chrono::milliseconds(1));
+		});
+	BOOST_CHECK(reused);
+}
+
+BOOST_AUTO_TEST_CASE(lowest_exception_is_rethrown)
+{
+	for (unsigned parallelism: {1u, 4u})
+	{
+		atomic<size_t> calls{0};
+		auto job = [&](size_t _index)
+		{
+			++calls;
+			if (_index == 3 || _index == 5)
+				throw runtime_error(to_string(_index));
+		};
+		try
+		{
+			parallelFor(8, parallelism, job);
+			BOOST_FAIL("Expected an exception.");
+		}
+		catch (runtime_error const& _exception)
+		{
+			BOOST_CHECK_EQUAL(string(_exception.what()), "3");
+		}
+		// Without parallelism, the jobs after the failing one are not run.
+		BOOST_CHECK_EQUAL(calls.load(), parallelism == 1 ? 4u : 8u);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -58,7 +58,7 @@ TestCase::TestResult ObjectCompilerTest::run(ostream& _stream, string const& _li
 	if (!stack.parseAndAnalyze("source", m_source))
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack);
 		return TestResult::FatalError;
 	}
 	stack.optimize();
@@ -94,9 +94,13 @@ TestCase::TestResult ObjectCompilerTest::run(ostream& _stream, string const& _li
 	return checkResult(_stream, _linePrefix, _formatted);
 }
 
-void ObjectCompilerTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void ObjectCompilerTest::printErrors(
+	ostream& _stream,
+	ErrorList const& _errors,
+	CharStreamProvider const& _charStreamProvider
+)
 {
-	SourceReferenceFormatter formatter(_stream, true, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
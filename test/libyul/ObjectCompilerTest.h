@@ -20,6 +20,8 @@
 
 #include <test/TestCase.h>
 
+#include <liblangutil/CharStreamProvider.h>
+
 namespace solidity::langutil
 {
 class Scanner;
@@ -52,7 +54,11 @@ private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	void disambiguate();
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	bool m_optimize = false;
 	bool m_wasm = false;
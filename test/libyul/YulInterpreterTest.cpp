@@ -79,7 +79,7 @@ bool YulInterpreterTest::parse(ostream& _stream, string const& _linePrefix, bool
 	else
 	{
 		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Error parsing source." << endl;
-		printErrors(_stream, stack.errors());
+		printErrors(_stream, stack.errors(), stack);
 		return false;
 	}
 }
@@ -103,9 +103,13 @@ string YulInterpreterTest::interpret()
 	return result.str();
 }
 
-void YulInterpreterTest::printErrors(ostream& _stream, ErrorList const& _errors)
+void YulInterpreterTest::printErrors(
+	ostream& _stream,
+	ErrorList const& _errors,
+	CharStreamProvider const& _charStreamProvider
+)
 {
-	SourceReferenceFormatter formatter(_stream, true, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, true, false);
 
 	for (auto const& error: _errors)
 		formatter.printErrorInformation(*error);
@@ -20,6 +20,8 @@
 
 #include <test/TestCase.h>
 
+#include <liblangutil/CharStreamProvider.h>
+
 namespace solidity::langutil
 {
 class Scanner;
@@ -52,7 +54,11 @@ private:
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	std::string interpret();
 
-	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
+	static void printErrors(
+		std::ostream& _stream,
+		langutil::ErrorList const& _errors,
+		langutil::CharStreamProvider const& _charStreamProvider
+	);
 
 	std::shared_ptr<Block> m_ast;
 	std::shared_ptr<AsmAnalysisInfo> m_analysisInfo;
@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+#include <libyul/AssemblyStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace std;
+using namespace solidity::frontend;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(string("ab") + "c");
+	YulString c("abd");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(c.str(), "abd");
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString("") == YulString{});
+	BOOST_CHECK(!a.empty());
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	// Enough strings to span several storage chunks.
+	size_t const stringCount = 20000;
+	vector<string> strings;
+	for (size_t i = 0; i < stringCount; ++i)
+		strings.emplace_back("concurrent_interning_" + to_string(i));
+
+	size_t const threadCount = 8;
+	vector<vector<YulString>> results(threadCount, vector<YulString>(stringCount));
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			vector<size_t> order(stringCount);
+			for (size_t i = 0; i < stringCount; ++i)
+				order[i] = i;
+			shuffle(order.begin(), order.end(), mt19937(static_cast<unsigned>(t)));
+			for (size_t i: order)
+				results[t][i] = YulString(strings[i]);
+		});
+	for (auto& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(results[0][i].str(), strings[i]);
+		for (size_t t = 1; t < threadCount; ++t)
+			BOOST_REQUIRE(results[t][i] == results[0][i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_optimisation)
+{
+	string const source = R"({
+		function f(a, b) -> c { c := add(mul(a, 2), b) }
+		function g(x) -> y { for { let i := 0 } lt(i, x) { i := add(i, 1) } { y := f(y, i) } }
+		sstore(0, g(calldataload(0)))
+		sstore(1, f(calldataload(32), 7))
+	})";
+	auto optimise = [&]() -> string {
+		AssemblyStack stack(
+			langutil::EVMVersion{},
+			AssemblyStack::Language::StrictAssembly,
+			OptimiserSettings::full()
+		);
+		if (!stack.parseAndAnalyze("", source))
+			return "";
+		stack.optimize();
+		return stack.print();
+	};
+
+	string const expectation = optimise();
+	BOOST_REQUIRE(!expectation.empty());
+
+	vector<string> results(4);
+	vector<thread> threads;
+	for (size_t t = 0; t < results.size(); ++t)
+		threads.emplace_back([&, t]() { results[t] = optimise(); });
+	for (auto& t: threads)
+		t.join();
+
+	for (string const& result: results)
+		BOOST_CHECK_EQUAL(result, expectation);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -24,12 +24,12 @@ solidity::bytes SolidityCompilationFramework::compileContract(
 	m_compiler.setOptimiserSettings(_optimization);
 	if (!m_compiler.compile())
 	{
-		langutil::SourceReferenceFormatter formatter(std::cerr, false, false);
+		langutil::SourceReferenceFormatter formatter(std::cerr, m_compiler, false, false);
 
 		for (auto const& error: m_compiler.errors())
 			formatter.printExceptionInformation(
 					*error,
-					formatter.formatErrorInformation(*error)
+					formatter.formatErrorInformation(*error, m_compiler)
 			);
 		std::cerr << "Compiling contract failed" << std::endl;
 	}
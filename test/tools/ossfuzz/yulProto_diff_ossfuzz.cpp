@@ -45,9 +45,9 @@ using namespace solidity::yul::test::yul_fuzzer;
 
 namespace
 {
-void printErrors(ostream& _stream, ErrorList const& _errors)
+void printErrors(ostream& _stream, ErrorList const& _errors, CharStreamProvider const& _charStreamProvider)
 {
-	SourceReferenceFormatter formatter(_stream, false, false);
+	SourceReferenceFormatter formatter(_stream, _charStreamProvider, false, false);
 
 	for (auto const& error: _errors)
 		formatter.printExceptionInformation(
@@ -88,7 +88,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 		!Error::containsOnlyWarnings(stack.errors())
 	)
 	{
-		printErrors(std::cout, stack.errors());
+		printErrors(std::cout, stack.errors(), stack);
 		yulAssert(false, "Proto fuzzer generated malformed program");
 	}
 
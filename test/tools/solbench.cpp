@@ -0,0 +1,599 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Throughput benchmarks of the compiler.
+ */
+
+#include <test/TestCaseReader.h>
+#include <test/libyul/YulOptimizerTestCommon.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/interface/Version.h>
+#include <libsolidity/parsing/Parser.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/YulString.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TimeReport.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::langutil;
+using namespace solidity::frontend;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Options
+{
+	fs::path testPath;
+	optional<regex> filter;
+	chrono::milliseconds minTime{500};
+	size_t minIterations = 5;
+};
+
+/// Durations of the iterations of a benchmark and the number of items processed per iteration.
+struct Result
+{
+	vector<double> nanoseconds;
+	uint64_t items = 0;
+	string unit;
+
+	double median() const
+	{
+		vector<double> sorted = nanoseconds;
+		sort(sorted.begin(), sorted.end());
+		size_t middle = sorted.size() / 2;
+		return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+	}
+	double minimum() const { return *min_element(nanoseconds.begin(), nanoseconds.end()); }
+};
+
+using Results = map<string, Result>;
+using Durations = map<string, chrono::nanoseconds>;
+
+class Benchmarks
+{
+public:
+	explicit Benchmarks(Options _options): m_options(move(_options)) {}
+
+	Results run()
+	{
+		scanner();
+		parser();
+		analysis();
+		yulOptimizer();
+		yulStringInterning();
+		keccak256Throughput();
+		standardJson();
+		return move(m_results);
+	}
+
+private:
+	bool selected(string const& _name) const
+	{
+		return !m_options.filter || regex_search(_name, *m_options.filter);
+	}
+
+	/// Calls @a _iteration once to warm up and then repeatedly, at least minIterations times and
+	/// until minTime has passed. Every call returns the measured durations by benchmark name, which
+	/// excludes setup work from the measurement and allows deriving several benchmarks from one run.
+	void measure(function<Durations()> const& _iteration)
+	{
+		_iteration();
+		auto const start = chrono::steady_clock::now();
+		for (
+			size_t iteration = 0;
+			iteration < m_options.minIterations || chrono::steady_clock::now() - start < m_options.minTime;
+			++iteration
+		)
+			for (auto const& [name, duration]: _iteration())
+				if (selected(name))
+					m_results[name].nanoseconds.push_back(static_cast<double>(duration.count()));
+	}
+
+	void setItems(string const& _name, uint64_t _items, string _unit)
+	{
+		if (m_results.count(_name))
+		{
+			m_results[_name].items = _items;
+			m_results[_name].unit = move(_unit);
+		}
+	}
+
+	template <typename F>
+	static chrono::nanoseconds timed(F const& _function)
+	{
+		auto const start = chrono::steady_clock::now();
+		_function();
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+	}
+
+	/// @returns the Solidity sources below @a _directory by path relative to it.
+	static StringMap solidityFiles(fs::path const& _directory)
+	{
+		StringMap sources;
+		for (fs::recursive_directory_iterator it(_directory), end; it != end; ++it)
+			if (fs::is_regular_file(it->path()) && it->path().extension() == ".sol")
+				sources[fs::relative(it->path(), _directory).generic_string()] = readFileAsString(it->path().string());
+		return sources;
+	}
+
+	/// @returns the sources of every project in test/compilationTests.
+	map<string, StringMap> const& projects()
+	{
+		if (m_projects.empty())
+			for (fs::directory_iterator it(m_options.testPath / "compilationTests"), end; it != end; ++it)
+				if (fs::is_directory(it->path()))
+					m_projects[it->path().filename().string()] = solidityFiles(it->path());
+		return m_projects;
+	}
+
+	StringMap allSources()
+	{
+		StringMap sources;
+		for (auto const& [project, projectSources]: projects())
+			for (auto const& [name, content]: projectSources)
+				sources[project + "/" + name] = content;
+		return sources;
+	}
+
+	void scanner()
+	{
+		if (!selected("scanner"))
+			return;
+		StringMap sources = allSources();
+		uint64_t tokens = 0;
+		measure([&]() {
+			tokens = 0;
+			return Durations{{"scanner", timed([&]() {
+				for (auto const& [name, content]: sources)
+					for (Scanner scanner(CharStream(content, name)); scanner.currentToken() != Token::EOS; scanner.next())
+						++tokens;
+			})}};
+		});
+		setItems("scanner", tokens, "tokens");
+	}
+
+	void parser()
+	{
+		if (!selected("parser"))
+			return;
+		StringMap sources = allSources();
+		uint64_t nodes = 0;
+		measure([&]() {
+			ErrorList errors;
+			ErrorReporter errorReporter(errors);
+			vector<ASTPointer<SourceUnit>> asts;
+			Durations durations{{"parser", timed([&]() {
+				Parser parser(errorReporter, EVMVersion{});
+				for (auto const& [name, content]: sources)
+					asts.push_back(parser.parse(make_shared<Scanner>(CharStream(content, name))));
+			})}};
+
+			nodes = 0;
+			SimpleASTVisitor counter([&](ASTNode const&) { ++nodes; return true; }, [](ASTNode const&) {});
+			for (auto const& ast: asts)
+				if (ast)
+					ast->accept(counter);
+			return durations;
+		});
+		setItems("parser", nodes, "nodes");
+	}
+
+	void analysis()
+	{
+		for (auto const& [project, sources]: projects())
+		{
+			string const analysisName = "analysis/" + project;
+			string const typeCheckerName = "typeChecker/" + project;
+			if (!selected(analysisName) && !selected(typeCheckerName))
+				continue;
+
+			measure([&]() {
+				CompilerStack stack;
+				stack.setSources(sources);
+				stack.setTimeReport(true);
+				if (!stack.parse())
+					throw runtime_error("Parsing " + project + " failed.");
+
+				Durations durations{{analysisName, timed([&]() { stack.analyze(); })}};
+				for (auto const& [scope, phases]: stack.timeReport()->scopes())
+					if (phases.count("analysis: TypeChecker"))
+						durations[typeCheckerName] += phases.at("analysis: TypeChecker").time;
+				return durations;
+			});
+			setItems(analysisName, sources.size(), "sources");
+			setItems(typeCheckerName, sources.size(), "sources");
+		}
+	}
+
+	void yulOptimizer()
+	{
+		fs::path const corpus = m_options.testPath / "libyul" / "yulOptimizerTests";
+		// These need the SMT solver or a different dialect.
+		set<string> const skippedSteps{"reasoningBasedSimplifier", "wordSizeTransform"};
+		EVMVersion const evmVersion = EVMVersion::berlin();
+
+		for (fs::directory_iterator it(corpus), end; it != end; ++it)
+		{
+			string const step = it->path().filename().string();
+			string const name = "yulOptimizer/" + step;
+			if (!fs::is_directory(it->path()) || skippedSteps.count(step) || !selected(name))
+				continue;
+
+			vector<string> sources;
+			for (fs::directory_iterator file(it->path()); file != end; ++file)
+			{
+				if (file->path().extension() != ".yul")
+					continue;
+				test::TestCaseReader reader(file->path().string());
+				if (reader.stringSetting("dialect", "evm") != "evm")
+					continue;
+				sources.push_back(reader.source());
+			}
+
+			auto parse = [&](string const& _source) -> shared_ptr<yul::Object>
+			{
+				yul::AssemblyStack stack(evmVersion, yul::AssemblyStack::Language::StrictAssembly, OptimiserSettings::none());
+				if (!stack.parseAndAnalyze("", _source))
+					return nullptr;
+				return stack.parserResult();
+			};
+			// Tests that do not compile with this EVM version are not part of the corpus.
+			sources.erase(
+				remove_if(sources.begin(), sources.end(), [&](string const& _source) { return !parse(_source); }),
+				sources.end()
+			);
+			if (sources.empty())
+				continue;
+
+			measure([&]() {
+				chrono::nanoseconds duration{0};
+				for (string const& source: sources)
+				{
+					yul::test::YulOptimizerTestCommon tester(parse(source), yul::EVMDialect::strictAssemblyForEVMObjects(evmVersion));
+					tester.setStep(step);
+					duration += timed([&]() { tester.runStep(); });
+				}
+				return Durations{{name, duration}};
+			});
+			setItems(name, sources.size(), "programs");
+		}
+	}
+
+	/// Interns the same identifiers from one and from several threads at the same time, starting
+	/// with an empty repository, so that both adding and looking up strings are measured.
+	void yulStringInterning()
+	{
+		size_t const threadCount = 4;
+		string const singleName = "yulString/1thread";
+		string const multiName = "yulString/" + to_string(threadCount) + "threads";
+		if (!selected(singleName) && !selected(multiName))
+			return;
+
+		vector<string> identifiers;
+		for (size_t i = 0; i < 20000; ++i)
+			identifiers.push_back("expr_" + to_string(i % 4000) + (i < 4000 ? "" : "_" + to_string(i / 4000)));
+		size_t const passes = 10;
+		atomic<uint64_t> ids{0};
+		auto intern = [&]()
+		{
+			uint64_t sum = 0;
+			for (size_t pass = 0; pass < passes; ++pass)
+				for (string const& identifier: identifiers)
+					sum += yul::YulString(identifier).hash();
+			ids += sum;
+		};
+
+		measure([&]() {
+			Durations durations;
+			yul::YulStringRepository::reset();
+			durations[singleName] = timed(intern);
+			yul::YulStringRepository::reset();
+			durations[multiName] = timed([&]() {
+				vector<thread> threads;
+				for (size_t i = 0; i < threadCount; ++i)
+					threads.emplace_back(intern);
+				for (thread& t: threads)
+					t.join();
+			});
+			return durations;
+		});
+		m_hashes += ids;
+		setItems(singleName, passes * identifiers.size(), "strings");
+		setItems(multiName, threadCount * passes * identifiers.size(), "strings");
+	}
+
+	void keccak256Throughput()
+	{
+		if (!selected("keccak256/1MiB") && !selected("keccak256/64B") && !selected("keccak256/64B-batch"))
+			return;
+		bytes const large(1024 * 1024, 0x5a);
+		bytes const small(64, 0x5a);
+		size_t const smallHashes = 100000;
+		vector<bytesConstRef> const batch(smallHashes, bytesConstRef(&small));
+		measure([&]() {
+			Durations durations;
+			durations["keccak256/1MiB"] = timed([&]() { m_hashes += keccak256(large)[0]; });
+			durations["keccak256/64B"] = timed([&]() {
+				for (size_t i = 0; i < smallHashes; ++i)
+					m_hashes += keccak256(small)[0];
+			});
+			durations["keccak256/64B-batch"] = timed([&]() {
+				for (h256 const& hash: keccak256(batch))
+					m_hashes += hash[0];
+			});
+			return durations;
+		});
+		setItems("keccak256/1MiB", large.size(), "bytes");
+		setItems("keccak256/64B", smallHashes, "hashes");
+		setItems("keccak256/64B-batch", smallHashes, "hashes");
+	}
+
+	void standardJson()
+	{
+		for (auto const& [project, sources]: projects())
+		{
+			string const compileName = "standardJson/" + project;
+			string const optimiseName = "evmasmOptimise/" + project;
+			string const assembleName = "evmasmAssemble/" + project;
+			if (!selected(compileName) && !selected(optimiseName) && !selected(assembleName))
+				continue;
+
+			Json::Value input;
+			input["language"] = "Solidity";
+			for (auto const& [name, content]: sources)
+				input["sources"][name]["content"] = content;
+			input["settings"]["optimizer"]["enabled"] = true;
+			input["settings"]["timeReport"] = true;
+			input["settings"]["outputSelection"]["*"]["*"].append("evm.bytecode");
+			input["settings"]["outputSelection"]["*"]["*"].append("evm.deployedBytecode");
+
+			measure([&]() {
+				Json::Value output;
+				Durations durations{{compileName, timed([&]() { output = StandardCompiler{}.compile(input); })}};
+				for (Json::Value const& error: output["errors"])
+					if (error["severity"].asString() == "error")
+						throw runtime_error("Compiling " + project + " failed: " + error["message"].asString());
+
+				durations[optimiseName] = chrono::nanoseconds{0};
+				durations[assembleName] = chrono::nanoseconds{0};
+				for (Json::Value const& phases: output["timeReport"])
+					for (string const& phase: phases.getMemberNames())
+					{
+						chrono::nanoseconds time{phases[phase]["nanoseconds"].asUInt64()};
+						if (boost::starts_with(phase, "EVM optimiser: "))
+							durations[optimiseName] += time;
+						else if (phase == "EVM assembly")
+							durations[assembleName] += time;
+					}
+				return durations;
+			});
+			for (string const& name: {compileName, optimiseName, assembleName})
+				setItems(name, sources.size(), "sources");
+		}
+	}
+
+	Options m_options;
+	Results m_results;
+	map<string, StringMap> m_projects;
+	/// Sum over the first byte of all computed hashes, so that hashing cannot be optimised away.
+	uint64_t m_hashes = 0;
+};
+
+Json::Value toJson(Results const& _results)
+{
+	Json::Value ret;
+	ret["version"] = VersionString;
+	ret["benchmarks"] = Json::objectValue;
+	for (auto const& [name, result]: _results)
+	{
+		Json::Value& benchmark = ret["benchmarks"][name];
+		benchmark["iterations"] = Json::UInt64(result.nanoseconds.size());
+		benchmark["medianNanoseconds"] = result.median();
+		benchmark["minimumNanoseconds"] = result.minimum();
+		benchmark["items"] = Json::UInt64(result.items);
+		benchmark["unit"] = result.unit;
+	}
+	return ret;
+}
+
+string formatDuration(double _nanoseconds)
+{
+	ostringstream ret;
+	ret << fixed << setprecision(3) << _nanoseconds / 1e6 << " ms";
+	return ret.str();
+}
+
+void printResults(Json::Value const& _results)
+{
+	for (string const& name: _results["benchmarks"].getMemberNames())
+	{
+		Json::Value const& benchmark = _results["benchmarks"][name];
+		double median = benchmark["medianNanoseconds"].asDouble();
+		cout << left << setw(48) << name << right;
+		cout << setw(14) << formatDuration(median);
+		cout << "  (min " << formatDuration(benchmark["minimumNanoseconds"].asDouble());
+		cout << ", " << benchmark["iterations"].asUInt64() << " iterations)";
+		if (benchmark["items"].asUInt64() > 0 && median > 0)
+			cout << "  " << setprecision(4) << static_cast<double>(benchmark["items"].asUInt64()) / median * 1e9
+				<< " " << benchmark["unit"].asString() << "/s";
+		cout << endl;
+	}
+}
+
+/// Prints the change of the median of every benchmark in @a _current relative to @a _baseline.
+/// @returns false if a benchmark became slower by more than @a _threshold percent.
+bool compare(Json::Value const& _baseline, Json::Value const& _current, double _threshold)
+{
+	cout << "Comparing " << _current["version"].asString() << " against " << _baseline["version"].asString() << ":" << endl;
+	bool success = true;
+	for (string const& name: _current["benchmarks"].getMemberNames())
+	{
+		cout << left << setw(48) << name << right;
+		if (!_baseline["benchmarks"].isMember(name))
+		{
+			cout << "  new" << endl;
+			continue;
+		}
+		double before = _baseline["benchmarks"][name]["medianNanoseconds"].asDouble();
+		double after = _current["benchmarks"][name]["medianNanoseconds"].asDouble();
+		double change = before > 0 ? (after / before - 1) * 100 : 0;
+		cout << setw(14) << formatDuration(before) << " -> " << setw(14) << formatDuration(after);
+		cout << "  " << showpos << fixed << setprecision(1) << change << "%" << noshowpos;
+		if (change > _threshold)
+		{
+			cout << "  REGRESSION";
+			success = false;
+		}
+		cout << endl;
+	}
+	for (string const& name: _baseline["benchmarks"].getMemberNames())
+		if (!_current["benchmarks"].isMember(name))
+			cout << left << setw(48) << name << right << "  removed" << endl;
+	return success;
+}
+
+Json::Value readResults(string const& _path)
+{
+	Json::Value results;
+	string errors;
+	if (!jsonParseStrict(readFileAsString(_path), results, &errors) || !results["benchmarks"].isObject())
+		throw runtime_error("Invalid benchmark results in " + _path + ": " + errors);
+	return results;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, throughput benchmarks of the compiler.
+Usage: solbench [Options]
+Runs the benchmarks, prints the results and optionally stores them as JSON
+or compares them against earlier results.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("testpath", po::value<string>()->default_value("test"), "Path to the test directory of the repository.")
+		("filter", po::value<string>(), "Only run the benchmarks whose name matches this regular expression.")
+		("min-time", po::value<unsigned>()->default_value(500), "Minimum time in milliseconds to run each benchmark.")
+		("min-iterations", po::value<size_t>()->default_value(5), "Minimum number of iterations of each benchmark.")
+		("output", po::value<string>(), "Store the results as JSON in this file.")
+		("compare", po::value<string>(), "Compare the results against the results stored in this file.")
+		("results", po::value<string>(), "Do not run the benchmarks, use the results stored in this file (requires --compare).")
+		("threshold", po::value<double>()->default_value(5.0), "Slowdown in percent that counts as a regression in --compare.")
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+	if (arguments.count("results") && !arguments.count("compare"))
+	{
+		cerr << "--results requires --compare." << endl;
+		return 1;
+	}
+
+	try
+	{
+		Json::Value results;
+		if (arguments.count("results"))
+			results = readResults(arguments["results"].as<string>());
+		else
+		{
+			Options benchmarkOptions;
+			benchmarkOptions.testPath = arguments["testpath"].as<string>();
+			if (arguments.count("filter"))
+				benchmarkOptions.filter = regex(arguments["filter"].as<string>());
+			benchmarkOptions.minTime = chrono::milliseconds(arguments["min-time"].as<unsigned>());
+			benchmarkOptions.minIterations = max<size_t>(arguments["min-iterations"].as<size_t>(), 1);
+
+			results = toJson(Benchmarks(move(benchmarkOptions)).run());
+			printResults(results);
+			if (arguments.count("output"))
+			{
+				ofstream output(arguments["output"].as<string>());
+				output << jsonPrettyPrint(results) << endl;
+				if (!output)
+					throw runtime_error("Could not write " + arguments["output"].as<string>() + ".");
+			}
+		}
+
+		if (arguments.count("compare"))
+			return compare(readResults(arguments["compare"].as<string>()), results, arguments["threshold"].as<double>()) ? 0 : 2;
+	}
+	catch (util::Exception const& _exception)
+	{
+		cerr << boost::diagnostic_information(_exception) << endl;
+		return 1;
+	}
+	catch (std::exception const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -68,12 +68,17 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	size_t copied = 0;
+	if (_sourceOffset < _source.size())
+	{
+		copied = min(_size, _source.size() - _sourceOffset);
+		_target.write(_targetOffset, bytesConstRef(_source.data() + _sourceOffset, copied));
+	}
+	_target.writeZeros(u256(_targetOffset) + copied, _size - copied);
 }
 
 }
@@ -267,7 +272,7 @@ u256 EVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.writeByte(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
 		return m_state.storage[h256(arg[0])];
@@ -492,21 +497,17 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 {
-	return u256(h256(readMemory(_offset, 32)));
+	return m_state.memory.readWord(_offset);
 }
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	m_state.memory.writeWord(_offset, _value);
 }
 
 
@@ -53,14 +53,12 @@ void InterpreterState::dumpTraceAndState(ostream& _out) const
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	for (auto const& [offset, value]: memory.nonZeroWords())
+		_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
 	_out << "Storage dump:" << endl;
-	for (auto const& slot: storage)
+	// Sort the slots so that the output does not depend on the layout of the hash table.
+	map<h256, h256> sortedStorage(storage.begin(), storage.end());
+	for (auto const& slot: sortedStorage)
 		if (slot.second != h256{})
 			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
 }
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <test/tools/yulInterpreter/InterpreterMemory.h>
+
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -29,7 +31,9 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <cstring>
 #include <map>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -67,14 +71,30 @@ enum class ControlFlowState
 	Leave
 };
 
+/// Hash function for storage slots, which combines all the bytes of the slot.
+struct StorageSlotHash
+{
+	size_t operator()(util::h256 const& _slot) const
+	{
+		size_t seed = 0;
+		for (size_t i = 0; i < util::h256::size; i += sizeof(uint64_t))
+		{
+			uint64_t word;
+			memcpy(&word, _slot.data() + i, sizeof(word));
+			boost::hash_combine(seed, word);
+		}
+		return seed;
+	}
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
-	/// This is different than memory.size() because we ignore gas.
+	InterpreterMemory memory;
+	/// This is different than the size of the written memory because we ignore gas.
 	u256 msize;
-	std::map<util::h256, util::h256> storage;
+	std::unordered_map<util::h256, util::h256, StorageSlotHash> storage;
 	u160 address = 0x11111111;
 	u256 balance = 0x22222222;
 	u256 selfbalance = 0x22223333;
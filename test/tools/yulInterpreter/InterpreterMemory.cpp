@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/InterpreterMemory.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul::test;
+
+using solidity::util::h256;
+
+namespace
+{
+
+size_t offsetInPage(u256 const& _offset)
+{
+	return static_cast<size_t>(_offset & (InterpreterMemory::PageSize - 1));
+}
+
+/// Splits the @a _size bytes starting at @a _offset into chunks that do not cross page
+/// boundaries and calls @a _callback with the page index, the offset inside the page,
+/// the offset inside the range and the size of each chunk.
+template <typename Callback>
+void forEachChunk(u256 _offset, size_t _size, Callback const& _callback)
+{
+	for (size_t position = 0; position < _size;)
+	{
+		size_t pageOffset = offsetInPage(_offset);
+		size_t chunkSize = min(_size - position, InterpreterMemory::PageSize - pageOffset);
+		_callback(u256(_offset >> InterpreterMemory::PageBits), pageOffset, position, chunkSize);
+		_offset += chunkSize;
+		position += chunkSize;
+	}
+}
+
+}
+
+uint8_t InterpreterMemory::readByte(u256 const& _offset) const
+{
+	Page const* page = findPage(_offset >> PageBits);
+	return page ? (*page)[offsetInPage(_offset)] : 0;
+}
+
+void InterpreterMemory::writeByte(u256 const& _offset, uint8_t _value)
+{
+	page(_offset >> PageBits)[offsetInPage(_offset)] = _value;
+}
+
+bytes InterpreterMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	forEachChunk(_offset, _size, [&](u256 const& _pageIndex, size_t _pageOffset, size_t _position, size_t _chunkSize) {
+		if (Page const* page = findPage(_pageIndex))
+			memcpy(data.data() + _position, page->data() + _pageOffset, _chunkSize);
+	});
+	return data;
+}
+
+u256 InterpreterMemory::readWord(u256 const& _offset) const
+{
+	size_t pageOffset = offsetInPage(_offset);
+	if (pageOffset + 32 > PageSize)
+		return u256(h256(read(_offset, 32)));
+
+	Page const* page = findPage(_offset >> PageBits);
+	if (!page)
+		return 0;
+	return u256(h256(bytesConstRef(page->data() + pageOffset, 32)));
+}
+
+void InterpreterMemory::write(u256 const& _offset, bytesConstRef _data)
+{
+	forEachChunk(_offset, _data.size(), [&](u256 const& _pageIndex, size_t _pageOffset, size_t _position, size_t _chunkSize) {
+		memcpy(page(_pageIndex).data() + _pageOffset, _data.data() + _position, _chunkSize);
+	});
+}
+
+void InterpreterMemory::writeWord(u256 const& _offset, u256 const& _value)
+{
+	h256 data(_value);
+	write(_offset, data.ref());
+}
+
+void InterpreterMemory::writeZeros(u256 const& _offset, size_t _size)
+{
+	forEachChunk(_offset, _size, [&](u256 const& _pageIndex, size_t _pageOffset, size_t, size_t _chunkSize) {
+		// Pages that were never written to are zero already.
+		if (findPage(_pageIndex))
+			memset(page(_pageIndex).data() + _pageOffset, 0, _chunkSize);
+	});
+}
+
+map<u256, u256> InterpreterMemory::nonZeroWords() const
+{
+	static_assert(PageSize % 32 == 0, "Words must not cross page boundaries.");
+
+	map<u256, u256> words;
+	for (auto const& [index, page]: m_pages)
+		for (size_t offset = 0; offset < PageSize; offset += 32)
+		{
+			auto word = page->begin() + static_cast<ptrdiff_t>(offset);
+			if (any_of(word, word + 32, [](uint8_t _byte) { return _byte != 0; }))
+				words[(index << PageBits) + offset] = u256(h256(bytesConstRef(&*word, 32)));
+		}
+	return words;
+}
+
+InterpreterMemory::Page const* InterpreterMemory::findPage(u256 const& _index) const
+{
+	auto it = m_pages.find(_index);
+	return it == m_pages.end() ? nullptr : it->second.get();
+}
+
+InterpreterMemory::Page& InterpreterMemory::page(u256 const& _index)
+{
+	unique_ptr<Page>& page = m_pages[_index];
+	if (!page)
+		page = make_unique<Page>();
+	return *page;
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/FixedHash.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Byte-addressed memory with 2**256 addresses that are all zero initially.
+ *
+ * The memory is split into pages of @a PageSize bytes that are only allocated when they
+ * are first written to, so that accessing far-apart addresses does not cost anything.
+ * Accesses that do not cross page boundaries are single copies from or to a page.
+ * Addresses wrap around at 2**256.
+ */
+class InterpreterMemory
+{
+public:
+	static constexpr unsigned PageBits = 12;
+	static constexpr size_t PageSize = size_t(1) << PageBits;
+
+	/// @returns the byte at @a _offset.
+	uint8_t readByte(u256 const& _offset) const;
+	void writeByte(u256 const& _offset, uint8_t _value);
+
+	/// @returns @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// @returns the 32 bytes starting at @a _offset as a big-endian number.
+	u256 readWord(u256 const& _offset) const;
+
+	/// Writes @a _data starting at @a _offset.
+	void write(u256 const& _offset, bytesConstRef _data);
+	/// Writes @a _value as 32 big-endian bytes starting at @a _offset.
+	void writeWord(u256 const& _offset, u256 const& _value);
+	/// Writes @a _size zero bytes starting at @a _offset.
+	void writeZeros(u256 const& _offset, size_t _size);
+
+	/// @returns the 32-byte words at offsets divisible by 32 that are not zero.
+	std::map<u256, u256> nonZeroWords() const;
+
+private:
+	using Page = std::array<uint8_t, PageSize>;
+
+	/// @returns the page with index @a _index or nullptr if it was not written to yet.
+	Page const* findPage(u256 const& _index) const;
+	/// @returns the page with index @a _index, allocating it if necessary.
+	Page& page(u256 const& _index);
+
+	/// Pages are allocated separately so that they do not move when the table grows.
+	std::unordered_map<u256, std::unique_ptr<Page>, boost::hash<u256>> m_pages;
+};
+
+}
@@ -77,7 +77,8 @@ class YulOpti
 public:
 	void printErrors()
 	{
-		SourceReferenceFormatter formatter(cerr, true, false);
+		SingletonCharStreamProvider charStreamProvider(*m_charStream);
+		SourceReferenceFormatter formatter(cerr, charStreamProvider, true, false);
 
 		for (auto const& error: m_errors)
 			formatter.printErrorInformation(*error);
@@ -87,6 +88,7 @@ public:
 	{
 		ErrorReporter errorReporter(m_errors);
 		shared_ptr<Scanner> scanner = make_shared<Scanner>(CharStream(_input, ""));
+		m_charStream = scanner->charStream();
 		m_ast = yul::Parser(errorReporter, m_dialect).parse(scanner, false);
 		if (!m_ast || !errorReporter.errors().empty())
 		{
@@ -224,6 +226,7 @@ public:
 
 private:
 	ErrorList m_errors;
+	shared_ptr<CharStream> m_charStream;
 	shared_ptr<yul::Block> m_ast;
 	Dialect const& m_dialect{EVMDialect::strictAssemblyForEVMObjects(EVMVersion{})};
 	shared_ptr<AsmAnalysisInfo> m_analysisInfo;
@@ -30,6 +30,7 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/tools/output_test_stream.hpp>
 
+#include <fstream>
 #include <regex>
 #include <sstream>
 
@@ -445,6 +446,53 @@ BOOST_FIXTURE_TEST_CASE(run_should_not_save_population_to_file_if_autosave_file_
 	BOOST_TEST(!fs::exists(m_autosavePath));
 }
 
+BOOST_FIXTURE_TEST_CASE(run_should_save_and_restore_program_caches_if_directory_specified, AlgorithmRunnerAutosaveFixture)
+{
+	m_options.maxRounds = 2;
+	m_options.programCacheDirectory = m_tempDir.memberPath("program-cache");
+
+	CharStream sourceStream("{mstore(10, 20)\nsstore(10, 20)}", "");
+	Program program = get<Program>(Program::load(sourceStream));
+	auto cache = make_shared<ProgramCache>(program);
+	shared_ptr<FitnessMetric> fitnessMetric = make_shared<ProgramSize>(nullopt, cache, CodeWeights{});
+	Population population = Population::makeRandom(fitnessMetric, 5, 1, 10);
+
+	AlgorithmRunner(population, {cache}, m_options, m_output).run(m_algorithm);
+	string cacheFile = m_tempDir.memberPath("program-cache/" + cache->programHash().hex() + ".json");
+	BOOST_TEST(fs::is_regular_file(cacheFile));
+	BOOST_REQUIRE(cache->size() > 0);
+
+	auto newCache = make_shared<ProgramCache>(program);
+	m_options.maxRounds = 0;
+	AlgorithmRunner(population, {newCache}, m_options, m_output).run(m_algorithm);
+	BOOST_TEST(newCache->size() == cache->size());
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_ignore_program_cache_that_cannot_be_restored, AlgorithmRunnerAutosaveFixture)
+{
+	m_options.maxRounds = 1;
+	m_options.programCacheDirectory = m_tempDir.memberPath("program-cache");
+
+	CharStream sourceStream("{mstore(10, 20)\nsstore(10, 20)}", "");
+	auto cache = make_shared<ProgramCache>(get<Program>(Program::load(sourceStream)));
+	shared_ptr<FitnessMetric> fitnessMetric = make_shared<ProgramSize>(nullopt, cache, CodeWeights{});
+	Population population = Population::makeRandom(fitnessMetric, 5, 1, 10);
+
+	string cacheFile = m_tempDir.memberPath("program-cache/" + cache->programHash().hex() + ".json");
+	fs::create_directories(m_tempDir.memberPath("program-cache"));
+	ofstream(cacheFile) << "{\"version\": ";
+
+	AlgorithmRunner(population, {cache}, m_options, m_output).run(m_algorithm);
+
+	BOOST_TEST(m_output.str().find("Warning: Ignoring program cache '" + cacheFile + "'") != string::npos);
+	BOOST_TEST(cache->size() > 0);
+	BOOST_TEST(!fs::exists(cacheFile + ".tmp"));
+
+	auto newCache = make_shared<ProgramCache>(cache->program());
+	ifstream cacheStream(cacheFile);
+	BOOST_TEST(newCache->restore(cacheStream) == cache->size());
+}
+
 BOOST_FIXTURE_TEST_CASE(run_should_randomise_duplicate_chromosomes_if_requested, AlgorithmRunnerFixture)
 {
 	Chromosome duplicate("afc");
@@ -277,6 +277,45 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(FitnessMetricTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_return_values_of_evaluate_in_order, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes = {
+		m_chromosome,
+		Chromosome(""),
+		Chromosome(vector<string>{UnusedPruner::name}),
+		Chromosome(vector<string>{EquivalentFunctionCombiner::name}),
+	};
+	ProgramSize sequentialMetric(m_program, nullptr, m_weights);
+
+	vector<size_t> expectedFitness;
+	for (auto const& chromosome: chromosomes)
+		expectedFitness.push_back(sequentialMetric.evaluate(chromosome));
+
+	BOOST_TEST(sequentialMetric.parallelism() == 1);
+	BOOST_TEST(sequentialMetric.evaluateAll(chromosomes) == expectedFitness);
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluateAll_should_give_the_same_results_when_evaluating_in_parallel_with_a_shared_cache, ProgramBasedMetricFixture)
+{
+	vector<Chromosome> chromosomes;
+	for (size_t i = 0; i < 20; ++i)
+		chromosomes.push_back(Chromosome::makeRandom(i % 5));
+	chromosomes.push_back(m_chromosome);
+
+	ProgramSize sequentialMetric(m_program, nullptr, m_weights);
+	FitnessMetricAverage parallelMetric({
+		make_shared<ProgramSize>(nullopt, m_programCache, m_weights),
+	});
+	parallelMetric.setParallelism(4);
+
+	BOOST_TEST(parallelMetric.parallelism() == 4);
+	BOOST_TEST(parallelMetric.evaluateAll(chromosomes) == sequentialMetric.evaluateAll(chromosomes));
+	BOOST_TEST(m_programCache->contains(toString(m_chromosome)));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
@@ -87,6 +87,7 @@ protected:
 		/* metricAggregator = */ MetricAggregatorChoice::Average,
 		/* relativeMetricScale = */ 5,
 		/* chromosomeRepetitions = */ 1,
+		/* jobs = */ 1,
 	};
 	CodeWeights const m_weights{};
 };
@@ -235,6 +236,14 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_respect_jobs_option, FitnessMetricFactoryFixture)
+{
+	m_options.jobs = 4;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+	BOOST_TEST(metric->parallelism() == m_options.jobs);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -385,7 +394,10 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheFactoryTest)
 
 BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cache_enabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true};
+	ProgramCacheFactory::Options options{
+		/* programCacheEnabled = */ true,
+		/* programCacheSizeLimit = */ nullopt,
+	};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -399,7 +411,10 @@ BOOST_FIXTURE_TEST_CASE(build_should_create_cache_for_each_input_program_if_cach
 
 BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_cache_disabled, FixtureWithPrograms)
 {
-	ProgramCacheFactory::Options options{/* programCacheEnabled = */ false};
+	ProgramCacheFactory::Options options{
+		/* programCacheEnabled = */ false,
+		/* programCacheSizeLimit = */ nullopt,
+	};
 	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
 	assert(m_programs.size() >= 2 && "There must be at least 2 programs for this test to be meaningful");
 
@@ -408,6 +423,23 @@ BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_ca
 		BOOST_TEST(caches[i] == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_size_limit_to_caches, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{
+		/* programCacheEnabled = */ true,
+		/* programCacheSizeLimit = */ 1000,
+	};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+
+	BOOST_TEST(caches.size() == m_programs.size());
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		BOOST_REQUIRE(caches[i] != nullptr);
+		BOOST_TEST(caches[i]->sizeLimit().has_value());
+		BOOST_TEST(caches[i]->sizeLimit().value() == 1000);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(ProgramFactoryTest)
 
@@ -18,6 +18,7 @@
 
 #include <tools/yulPhaser/ProgramCache.h>
 #include <tools/yulPhaser/Chromosome.h>
+#include <tools/yulPhaser/Exceptions.h>
 
 #include <libyul/optimiser/Metrics.h>
 
@@ -27,6 +28,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
 #include <string>
 #include <set>
 
@@ -59,9 +61,9 @@ protected:
 
 	static set<string> cachedKeys(ProgramCache const& _programCache)
 	{
-		 set<string> keys;
-		for (auto pair = _programCache.entries().begin(); pair != _programCache.entries().end(); ++pair)
-			keys.insert(pair->first);
+		set<string> keys;
+		for (auto const& [key, entry]: _programCache.entries())
+			keys.insert(key);
 
 		return keys;
 	}
@@ -252,6 +254,100 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_remove_least_recently_used_entries_if_size_limit_exceeded, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+
+	ProgramCache cache(m_program, sizeI + sizeIu + sizeL);
+	cache.optimiseProgram("Iu");
+	cache.optimiseProgram("L");
+	BOOST_REQUIRE((cachedKeys(cache) == set<string>{"I", "Iu", "L"}));
+
+	// Using "I" makes "Iu" the least recently used entry.
+	cache.optimiseProgram("I");
+	cache.optimiseProgram("IO");
+	BOOST_TEST(cachedKeys(cache).count("Iu") == 0);
+	BOOST_TEST(cachedKeys(cache).count("I") == 1);
+	BOOST_TEST(cachedKeys(cache).count("IO") == 1);
+	BOOST_TEST(cache.gatherStats().totalCodeSize <= sizeI + sizeIu + sizeL);
+}
+
+BOOST_FIXTURE_TEST_CASE(startRound_should_not_remove_entries_if_size_limit_set, ProgramCacheFixture)
+{
+	ProgramCache cache(m_program, 1000000);
+	cache.optimiseProgram("Iu");
+
+	cache.startRound(1);
+	cache.startRound(2);
+	cache.startRound(3);
+
+	BOOST_TEST((cachedKeys(cache) == set<string>{"I", "Iu"}));
+}
+
+BOOST_FIXTURE_TEST_CASE(restore_should_add_programs_saved_by_store, ProgramCacheFixture)
+{
+	m_programCache.optimiseProgram("IuO");
+	m_programCache.optimiseProgram("L");
+	stringstream storedCache;
+	m_programCache.store(storedCache);
+
+	ProgramCache restoredCache(m_program);
+	BOOST_TEST(restoredCache.restore(storedCache) == 4);
+
+	BOOST_REQUIRE((cachedKeys(restoredCache) == set<string>{"I", "Iu", "IuO", "L"}));
+	for (string steps: {"I", "Iu", "IuO", "L"})
+		BOOST_TEST(toString(*restoredCache.find(steps)) == toString(*m_programCache.find(steps)));
+	BOOST_TEST(restoredCache.gatherStats().totalCodeSize == m_programCache.gatherStats().totalCodeSize);
+
+	CacheStats statsBefore = restoredCache.gatherStats();
+	BOOST_TEST(toString(restoredCache.optimiseProgram("IuO")) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(restoredCache.gatherStats().hits == statsBefore.hits + 3);
+	BOOST_TEST(restoredCache.gatherStats().misses == statsBefore.misses);
+}
+
+BOOST_FIXTURE_TEST_CASE(restored_programs_should_be_optimised_like_the_original_ones, ProgramCacheFixture)
+{
+	// The prefixes remove some of the variables introduced by their steps so the suffixes
+	// must not reuse their names.
+	for (auto const& [prefix, suffix]: vector<pair<string, string>>{{"xj", "x"}, {"xaj", "xa"}, {"IxsjO", "xL"}})
+	{
+		ProgramCache coldCache(m_program);
+		ProgramCache storingCache(m_program);
+		storingCache.optimiseProgram(prefix);
+		stringstream storedCache;
+		storingCache.store(storedCache);
+
+		ProgramCache restoredCache(m_program);
+		BOOST_REQUIRE(restoredCache.restore(storedCache) == prefix.size());
+		BOOST_TEST(
+			toString(restoredCache.optimiseProgram(prefix + suffix)) ==
+			toString(coldCache.optimiseProgram(prefix + suffix))
+		);
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(restore_should_ignore_programs_stored_for_a_different_program, ProgramCacheFixture)
+{
+	m_programCache.optimiseProgram("Iu");
+	stringstream storedCache;
+	m_programCache.store(storedCache);
+
+	CharStream otherSourceStream("{ mstore(1, 2) }", "");
+	ProgramCache otherCache(get<Program>(Program::load(otherSourceStream)));
+
+	BOOST_TEST(otherCache.restore(storedCache) == 0);
+	BOOST_TEST(otherCache.size() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(restore_should_throw_if_input_is_not_a_stored_cache, ProgramCacheFixture)
+{
+	stringstream input("not a program cache");
+
+	BOOST_CHECK_THROW(m_programCache.restore(input), BadInput);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -347,7 +347,7 @@ bool SourceUpgrade::analyzeAndUpgrade(pair<string, string> const& _sourceCode)
 		log() << "Analyzing and upgrading " << _sourceCode.first << "." << endl;
 
 	if (m_compiler->state() >= CompilerStack::State::AnalysisPerformed)
-		m_suite.analyze(m_compiler->ast(_sourceCode.first));
+		m_suite.analyze(*m_compiler, m_compiler->ast(_sourceCode.first));
 
 	if (!m_suite.changes().empty())
 	{
@@ -397,7 +397,7 @@ void SourceUpgrade::applyChange(
 
 void SourceUpgrade::printErrors() const
 {
-	auto formatter = make_unique<langutil::SourceReferenceFormatter>(cout, true, false);
+	auto formatter = make_unique<langutil::SourceReferenceFormatter>(cout, *m_compiler, true, false);
 
 	for (auto const& error: m_compiler->errors())
 		if (error->type() != langutil::Error::Type::Warning)
@@ -34,9 +34,10 @@ void ConstructorKeyword::endVisit(ContractDefinition const& _contract)
 	for (auto const* function: _contract.definedFunctions())
 		if (function->name() == _contract.name())
 			m_changes.emplace_back(
+					m_charStreamProvider,
 					UpgradeChange::Level::Safe,
 					function->location(),
-					SourceTransform::replaceFunctionName(
+					SourceTransform{m_charStreamProvider}.replaceFunctionName(
 						function->location(),
 						function->name(),
 						"constructor"
@@ -48,8 +49,9 @@ void VisibilitySpecifier::endVisit(FunctionDefinition const& _function)
 {
 	if (_function.noVisibilitySpecified())
 		m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				_function.location(),
-				SourceTransform::insertAfterRightParenthesis(_function.location(), "public")
+				SourceTransform{m_charStreamProvider}.insertAfterRightParenthesis(_function.location(), "public")
 		);
 }
@@ -27,6 +27,7 @@
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
+using namespace solidity::langutil;
 using namespace solidity::tools;
 
 using Contracts = set<ContractDefinition const*, OverrideChecker::CompareByID>;
@@ -35,6 +36,7 @@ namespace
 {
 
 inline string appendOverride(
+	CharStreamProvider const& _charStreamProvider,
 	FunctionDefinition const& _function,
 	Contracts const& _expectedContracts
 )
@@ -42,27 +44,29 @@ inline string appendOverride(
 	auto location = _function.location();
 	string upgradedCode;
 	string overrideExpression = SourceGeneration::functionOverride(_expectedContracts);
+	SourceAnalysis analysis{_charStreamProvider};
+	SourceTransform transform{_charStreamProvider};
 
-	if (SourceAnalysis::hasVirtualKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	if (analysis.hasVirtualKeyword(location))
+		upgradedCode = transform.insertAfterKeyword(
 			location,
 			"virtual",
 			overrideExpression
 		);
-	else if (SourceAnalysis::hasMutabilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (analysis.hasMutabilityKeyword(location))
+		upgradedCode = transform.insertAfterKeyword(
 			location,
 			stateMutabilityToString(_function.stateMutability()),
 			overrideExpression
 		);
-	else if (SourceAnalysis::hasVisibilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (analysis.hasVisibilityKeyword(location))
+		upgradedCode = transform.insertAfterKeyword(
 			location,
 			Declaration::visibilityToString(_function.visibility()),
 			overrideExpression
 		);
 	else
-		upgradedCode = SourceTransform::insertAfterRightParenthesis(
+		upgradedCode = transform.insertAfterRightParenthesis(
 			location,
 			overrideExpression
 		);
@@ -70,25 +74,27 @@ inline string appendOverride(
 	return upgradedCode;
 }
 
-inline string appendVirtual(FunctionDefinition const& _function)
+inline string appendVirtual(CharStreamProvider const& _charStreamProvider, FunctionDefinition const& _function)
 {
 	auto location = _function.location();
 	string upgradedCode;
+	SourceAnalysis analysis{_charStreamProvider};
+	SourceTransform transform{_charStreamProvider};
 
-	if (SourceAnalysis::hasMutabilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	if (analysis.hasMutabilityKeyword(location))
+		upgradedCode = transform.insertAfterKeyword(
 			location,
 			stateMutabilityToString(_function.stateMutability()),
 			"virtual"
 		);
-	else if (SourceAnalysis::hasVisibilityKeyword(location))
-		upgradedCode = SourceTransform::insertAfterKeyword(
+	else if (analysis.hasVisibilityKeyword(location))
+		upgradedCode = transform.insertAfterKeyword(
 			location,
 			Declaration::visibilityToString(_function.visibility()),
 			"virtual"
 		);
 	else
-		upgradedCode = SourceTransform::insertAfterRightParenthesis(
+		upgradedCode = transform.insertAfterRightParenthesis(
 			_function.location(),
 			"virtual"
 		);
@@ -108,9 +114,10 @@ void AbstractContract::endVisit(ContractDefinition const& _contract)
 		!_contract.isInterface()
 	)
 		m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				_contract.location(),
-				SourceTransform::insertBeforeKeyword(_contract.location(), "contract", "abstract")
+				SourceTransform{m_charStreamProvider}.insertBeforeKeyword(_contract.location(), "contract", "abstract")
 		);
 }
 
@@ -132,9 +139,10 @@ void OverridingFunction::endVisit(ContractDefinition const& _contract)
 			/// Add override with contract list, if needed.
 			if (!function->overrides() && expectedContracts.size() > 1)
 				m_changes.emplace_back(
+						m_charStreamProvider,
 						UpgradeChange::Level::Safe,
 						function->location(),
-						appendOverride(*function, expectedContracts)
+						appendOverride(m_charStreamProvider, *function, expectedContracts)
 				);
 
 			for (auto [begin, end] = inheritedFunctions.equal_range(proxy); begin != end; begin++)
@@ -149,9 +157,10 @@ void OverridingFunction::endVisit(ContractDefinition const& _contract)
 					/// contract list was added before.
 					if (!function->overrides() && expectedContracts.size() <= 1)
 						m_changes.emplace_back(
+								m_charStreamProvider,
 								UpgradeChange::Level::Safe,
 								function->location(),
-								appendOverride(*function, expectedContracts)
+								appendOverride(m_charStreamProvider, *function, expectedContracts)
 						);
 				}
 			}
@@ -177,9 +186,10 @@ void VirtualFunction::endVisit(ContractDefinition const& _contract)
 			)
 			{
 				m_changes.emplace_back(
+						m_charStreamProvider,
 						UpgradeChange::Level::Safe,
 						function->location(),
-						appendVirtual(*function)
+						appendVirtual(m_charStreamProvider, *function)
 				);
 			}
 
@@ -192,9 +202,10 @@ void VirtualFunction::endVisit(ContractDefinition const& _contract)
 				)
 				{
 					m_changes.emplace_back(
+							m_charStreamProvider,
 							UpgradeChange::Level::Safe,
 							function->location(),
-							appendVirtual(*function)
+							appendVirtual(m_charStreamProvider, *function)
 					);
 				}
 			}
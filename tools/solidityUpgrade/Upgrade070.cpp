@@ -27,16 +27,18 @@ void DotSyntax::endVisit(FunctionCall const& _functionCall)
 	{
 		if (funcType->valueSet())
 			m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				_functionCall.location(),
-				SourceTransform::valueUpdate(_functionCall.location())
+				SourceTransform{m_charStreamProvider}.valueUpdate(_functionCall.location())
 			);
 
 		if (funcType->gasSet())
 			m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				_functionCall.location(),
-				SourceTransform::gasUpdate(_functionCall.location())
+				SourceTransform{m_charStreamProvider}.gasUpdate(_functionCall.location())
 			);
 	}
 }
@@ -53,9 +55,10 @@ void NowKeyword::endVisit(Identifier const& _identifier)
 		{
 			solAssert(_identifier.name() == "now", "");
 			m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				_identifier.location(),
-				SourceTransform::nowUpdate(_identifier.location())
+				SourceTransform{m_charStreamProvider}.nowUpdate(_identifier.location())
 			);
 		}
 }
@@ -70,16 +73,18 @@ void ConstructorVisibility::endVisit(ContractDefinition const& _contract)
 				function->visibility() == Visibility::Internal
 			)
 				m_changes.emplace_back(
+					m_charStreamProvider,
 					UpgradeChange::Level::Safe,
 					_contract.location(),
-					SourceTransform::insertBeforeKeyword(_contract.location(), "contract", "abstract")
+					SourceTransform{m_charStreamProvider}.insertBeforeKeyword(_contract.location(), "contract", "abstract")
 				);
 
 	for (FunctionDefinition const* function: _contract.definedFunctions())
 		if (function->isConstructor() && !function->noVisibilitySpecified())
 			m_changes.emplace_back(
+				m_charStreamProvider,
 				UpgradeChange::Level::Safe,
 				function->location(),
-				SourceTransform::removeVisibility(function->location())
+				SourceTransform{m_charStreamProvider}.removeVisibility(function->location())
 			);
 }
@@ -37,7 +37,8 @@ void UpgradeChange::apply()
 void UpgradeChange::log(bool const _shorten) const
 {
 	stringstream os;
-	SourceReferenceFormatter formatter{os, true, false};
+	SingletonCharStreamProvider charStreamProvider(m_charStream);
+	SourceReferenceFormatter formatter{os, charStreamProvider, true, false};
 
 	string start = to_string(m_location.start);
 	string end = to_string(m_location.end);
@@ -48,10 +49,10 @@ void UpgradeChange::log(bool const _shorten) const
 	os << endl;
 	AnsiColorized(os, true, {formatting::BOLD, color}) << "Upgrade change (" << level << ")" << endl;
 	os << "=======================" << endl;
-	formatter.printSourceLocation(SourceReferenceExtractor::extract(&m_location));
+	formatter.printSourceLocation(SourceReferenceExtractor::extract(charStreamProvider, &m_location));
 	os << endl;
 
-	LineColumn lineEnd = m_location.source->translatePositionToLineColumn(m_location.end);
+	LineColumn lineEnd = m_charStream.translatePositionToLineColumn(m_location.end);
 	int const leftpad = static_cast<int>(log10(max(lineEnd.line, 1))) + 2;
 
 	stringstream output;
@@ -18,6 +18,7 @@
 
 #include <libsolutil/AnsiColorized.h>
 
+#include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/SourceLocation.h>
 
 #include <algorithm>
@@ -44,13 +45,15 @@ public:
 	};
 
 	UpgradeChange(
+		langutil::CharStreamProvider const& _charStreamProvider,
 		Level _level,
 		langutil::SourceLocation _location,
 		std::string _patch
 	)
 	:
 		m_location(_location),
-		m_source(_location.source->source()),
+		m_charStream(*_charStreamProvider.charStream(*_location.sourceName)),
+		m_source(m_charStream.source()),
 		m_patch(std::move(_patch)),
 		m_level(_level) {}
 
@@ -72,6 +75,8 @@ public:
 	void log(bool const _shorten = true) const;
 private:
 	langutil::SourceLocation m_location;
+	/// The original source code, which the location refers to.
+	langutil::CharStream m_charStream;
 	std::string m_source;
 	std::string m_patch;
 	Level m_level;
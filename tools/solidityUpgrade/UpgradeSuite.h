@@ -37,9 +37,14 @@ namespace solidity::tools
 class Upgrade
 {
 public:
-	Upgrade(std::vector<UpgradeChange>& _changes): m_changes(_changes) {}
+	Upgrade(langutil::CharStreamProvider const& _charStreamProvider, std::vector<UpgradeChange>& _changes):
+		m_charStreamProvider(_charStreamProvider),
+		m_changes(_changes)
+	{}
 
 protected:
+	/// Provides the source code of the locations analyzed.
+	langutil::CharStreamProvider const& m_charStreamProvider;
 	/// A reference to a suite-specific set of changes.
 	/// It is passed to all upgrade modules and meant to collect
 	/// reported changes.
@@ -53,8 +58,8 @@ protected:
 class AnalysisUpgrade: public Upgrade, public frontend::ASTConstVisitor
 {
 public:
-	AnalysisUpgrade(std::vector<UpgradeChange>& _changes):
-		Upgrade(_changes),
+	AnalysisUpgrade(langutil::CharStreamProvider const& _charStreamProvider, std::vector<UpgradeChange>& _changes):
+		Upgrade(_charStreamProvider, _changes),
 		m_errorReporter(m_errors),
 		m_overrideChecker(m_errorReporter)
 	{}
@@ -77,7 +82,7 @@ public:
 	/// The base interface function that needs to be implemented for each
 	/// suite. It should create suite-specific upgrade modules and trigger
 	/// their analysis.
-	void analyze(frontend::SourceUnit const& _sourceUnit);
+	void analyze(langutil::CharStreamProvider const& _charStreamProvider, frontend::SourceUnit const& _sourceUnit);
 	/// Resets all changes collected so far.
 	void reset() { m_changes.clear(); }
 
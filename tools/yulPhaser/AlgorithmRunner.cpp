@@ -22,6 +22,8 @@
 
 #include <libsolutil/Assertions.h>
 
+#include <boost/filesystem.hpp>
+
 #include <cerrno>
 #include <cstring>
 #include <fstream>
@@ -34,6 +36,7 @@ void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 	populationAutosave();
 	printInitialPopulation();
 	cacheClear();
+	cacheRestore();
 
 	clock_t totalTimeStart = clock();
 	for (size_t round = 0; !m_options.maxRounds.has_value() || round < m_options.maxRounds.value(); ++round)
@@ -47,6 +50,7 @@ void AlgorithmRunner::run(GeneticAlgorithm& _algorithm)
 		printRoundSummary(round, roundTimeStart, totalTimeStart);
 		printCacheStats();
 		populationAutosave();
+		cacheStore();
 	}
 }
 
@@ -150,6 +154,86 @@ void AlgorithmRunner::populationAutosave() const
 	);
 }
 
+void AlgorithmRunner::cacheStore() const
+{
+	if (!m_options.programCacheDirectory.has_value())
+		return;
+
+	boost::filesystem::create_directories(m_options.programCacheDirectory.value());
+	for (auto const& cache: m_programCaches)
+		if (cache != nullptr)
+		{
+			// Write to a temporary file first so that an interrupted run cannot leave
+			// a truncated cache behind.
+			string filePath = cacheFilePath(*cache);
+			string temporaryFilePath = filePath + ".tmp";
+			{
+				ofstream outputStream(temporaryFilePath, ios::out | ios::trunc);
+				assertThrow(
+					outputStream.is_open(),
+					FileOpenError,
+					"Could not open file '" + temporaryFilePath + "': " + strerror(errno)
+				);
+
+				cache->store(outputStream);
+				outputStream.close();
+
+				assertThrow(
+					!outputStream.fail(),
+					FileWriteError,
+					"Error while writing to file '" + temporaryFilePath + "': " + strerror(errno)
+				);
+			}
+
+			boost::system::error_code error;
+			boost::filesystem::rename(temporaryFilePath, filePath, error);
+			assertThrow(
+				!error,
+				FileWriteError,
+				"Could not rename file '" + temporaryFilePath + "' to '" + filePath + "': " + error.message()
+			);
+		}
+}
+
+void AlgorithmRunner::cacheRestore()
+{
+	if (!m_options.programCacheDirectory.has_value())
+		return;
+
+	for (auto& cache: m_programCaches)
+		if (cache != nullptr)
+		{
+			string filePath = cacheFilePath(*cache);
+			if (!boost::filesystem::exists(filePath))
+				continue;
+
+			// The cache only saves time, so a cache that cannot be used is not an error.
+			ifstream inputStream(filePath);
+			if (!inputStream.is_open())
+			{
+				m_outputStream << "Warning: Ignoring program cache '" << filePath << "': ";
+				m_outputStream << "Could not open file: " << strerror(errno) << endl;
+				continue;
+			}
+
+			try
+			{
+				cache->restore(inputStream);
+			}
+			catch (BadInput const& _exception)
+			{
+				m_outputStream << "Warning: Ignoring program cache '" << filePath << "': ";
+				m_outputStream << _exception.what() << endl;
+			}
+		}
+}
+
+string AlgorithmRunner::cacheFilePath(ProgramCache const& _programCache) const
+{
+	boost::filesystem::path directory(m_options.programCacheDirectory.value());
+	return (directory / (_programCache.programHash().hex() + ".json")).string();
+}
+
 void AlgorithmRunner::cacheClear()
 {
 	for (auto& cache: m_programCaches)
@@ -46,6 +46,7 @@ public:
 	{
 		std::optional<size_t> maxRounds = std::nullopt;
 		std::optional<std::string> populationAutosaveFile = std::nullopt;
+		std::optional<std::string> programCacheDirectory = std::nullopt;
 		bool randomiseDuplicates = false;
 		std::optional<size_t> minChromosomeLength = std::nullopt;
 		std::optional<size_t> maxChromosomeLength = std::nullopt;
@@ -80,9 +81,12 @@ private:
 	void printInitialPopulation() const;
 	void printCacheStats() const;
 	void populationAutosave() const;
+	void cacheStore() const;
+	void cacheRestore();
 	void randomiseDuplicates();
 	void cacheClear();
 	void cacheStartRound(size_t _roundNumber);
+	std::string cacheFilePath(ProgramCache const& _programCache) const;
 
 	static Population randomiseDuplicates(
 		Population _population,
@@ -19,6 +19,7 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Parallel.h>
 
 #include <cmath>
 
@@ -27,6 +28,16 @@ using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
+vector<size_t> FitnessMetric::evaluateAll(vector<Chromosome> const& _chromosomes)
+{
+	vector<size_t> values(_chromosomes.size());
+	parallelFor(_chromosomes.size(), m_parallelism, [&](size_t _index) {
+		values[_index] = evaluate(_chromosomes[_index]);
+	});
+
+	return values;
+}
+
 Program const& ProgramBasedMetric::program() const
 {
 	if (m_programCache == nullptr)
@@ -29,6 +29,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 namespace solidity::phaser
 {
@@ -39,6 +40,9 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ *
+ * @a evaluateAll() evaluates multiple chromosomes at once, using up to @a parallelism() threads.
+ * Metrics used with parallelism greater than one must allow concurrent calls to @a evaluate().
  */
 class FitnessMetric
 {
@@ -49,6 +53,15 @@ public:
 	virtual ~FitnessMetric() = default;
 
 	virtual size_t evaluate(Chromosome const& _chromosome) = 0;
+
+	/// @returns the values of @a evaluate() for all chromosomes, in the same order.
+	std::vector<size_t> evaluateAll(std::vector<Chromosome> const& _chromosomes);
+
+	unsigned parallelism() const { return m_parallelism; }
+	void setParallelism(unsigned _parallelism) { m_parallelism = _parallelism; }
+
+private:
+	unsigned m_parallelism = 1;
 };
 
 /**
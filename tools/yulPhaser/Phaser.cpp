@@ -27,6 +27,8 @@
 #include <tools/yulPhaser/SimulationRNG.h>
 
 #include <liblangutil/CharStream.h>
+#include <liblangutil/CharStreamProvider.h>
+#include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
@@ -218,6 +220,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["jobs"].as<unsigned>(),
 	};
 }
 
@@ -262,19 +265,27 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	unique_ptr<FitnessMetric> metric;
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
-			return make_unique<FitnessMetricAverage>(move(metrics));
+			metric = make_unique<FitnessMetricAverage>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Sum:
-			return make_unique<FitnessMetricSum>(move(metrics));
+			metric = make_unique<FitnessMetricSum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Maximum:
-			return make_unique<FitnessMetricMaximum>(move(metrics));
+			metric = make_unique<FitnessMetricMaximum>(move(metrics));
+			break;
 		case MetricAggregatorChoice::Minimum:
-			return make_unique<FitnessMetricMinimum>(move(metrics));
+			metric = make_unique<FitnessMetricMinimum>(move(metrics));
+			break;
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricAggregatorChoice value.");
 	}
+
+	metric->setParallelism(_options.jobs);
+	return metric;
 }
 
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
@@ -357,6 +368,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("program-cache-size-limit") > 0 ?
+			static_cast<optional<size_t>>(_arguments["program-cache-size-limit"].as<size_t>()) :
+			nullopt,
 	};
 }
 
@@ -367,7 +381,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(move(program), _options.programCacheSizeLimit) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -389,7 +407,11 @@ vector<Program> ProgramFactory::build(Options const& _options)
 		variant<Program, ErrorList> programOrErrors = Program::load(sourceCode);
 		if (holds_alternative<ErrorList>(programOrErrors))
 		{
-			cerr << get<ErrorList>(programOrErrors) << endl;
+			SingletonCharStreamProvider charStreamProvider(sourceCode);
+			SourceReferenceFormatter formatter(cerr, charStreamProvider, true, false);
+			for (auto const& error: get<ErrorList>(programOrErrors))
+				formatter.printErrorInformation(*error);
+			cerr << endl;
 			assertThrow(false, InvalidProgram, "Failed to load program " + path);
 		}
 
@@ -676,6 +698,13 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"jobs",
+			po::value<unsigned>()->value_name("<NUM>")->default_value(1),
+			"Number of threads used to evaluate the fitness of the chromosomes of a population. "
+			"The results do not depend on this value. "
+			"Note that each thread holds its own copies of the programs being optimised."
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -708,8 +737,24 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default since it can take a lot of memory unless limited with "
+			"--program-cache-size-limit but highly recommended if your computer has enough RAM."
+		)
+		(
+			"program-cache-size-limit",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Maximum total size of the programs stored in the cache of each input program, "
+			"measured in AST nodes. When the cache grows larger, the least recently used programs "
+			"are removed. Without a limit, the programs that were not used in the current or "
+			"the previous round are removed at the beginning of each round."
+		)
+		(
+			"program-cache-dir",
+			po::value<string>()->value_name("<DIR>"),
+			"Directory where the programs in the cache are saved after each round. "
+			"Programs saved there by an earlier run on the same input program are loaded at startup "
+			"so that common prefixes do not have to be optimised again. "
+			"Has no effect unless --program-cache is enabled."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -791,6 +836,7 @@ AlgorithmRunner::Options Phaser::buildAlgorithmRunnerOptions(po::variables_map c
 	return {
 		_arguments.count("rounds") > 0 ? static_cast<optional<size_t>>(_arguments["rounds"].as<size_t>()) : nullopt,
 		_arguments.count("population-autosave") > 0 ? static_cast<optional<string>>(_arguments["population-autosave"].as<string>()) : nullopt,
+		_arguments.count("program-cache-dir") > 0 ? static_cast<optional<string>>(_arguments["program-cache-dir"].as<string>()) : nullopt,
 		!_arguments["no-randomise-duplicates"].as<bool>(),
 		_arguments["min-chromosome-length"].as<size_t>(),
 		_arguments["max-chromosome-length"].as<size_t>(),
@@ -156,6 +156,7 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		unsigned jobs;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
@@ -214,6 +215,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> programCacheSizeLimit;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
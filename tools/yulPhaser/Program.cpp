@@ -20,7 +20,6 @@
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/ErrorReporter.h>
-#include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -58,16 +57,6 @@ ostream& operator<<(ostream& _stream, Program const& _program);
 
 }
 
-ostream& std::operator<<(ostream& _outputStream, ErrorList const& _errors)
-{
-	SourceReferenceFormatter formatter(_outputStream, true, false);
-
-	for (auto const& error: _errors)
-		formatter.printErrorInformation(*error);
-
-	return _outputStream;
-}
-
 Program::Program(Program const& program):
 	m_ast(make_unique<Block>(get<Block>(ASTCopier{}(*program.m_ast)))),
 	m_dialect{program.m_dialect},
@@ -108,6 +97,32 @@ variant<Program, ErrorList> Program::load(CharStream& _sourceCode)
 	return program;
 }
 
+variant<Program, ErrorList> Program::loadPrepared(
+	CharStream& _sourceCode,
+	set<YulString> _usedNames,
+	size_t _nameCounter
+)
+{
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+
+	variant<unique_ptr<Block>, ErrorList> astOrErrors = parseObject(dialect, _sourceCode);
+	if (holds_alternative<ErrorList>(astOrErrors))
+		return get<ErrorList>(astOrErrors);
+
+	variant<unique_ptr<AsmAnalysisInfo>, ErrorList> analysisInfoOrErrors = analyzeAST(
+		dialect,
+		*get<unique_ptr<Block>>(astOrErrors)
+	);
+	if (holds_alternative<ErrorList>(analysisInfoOrErrors))
+		return get<ErrorList>(analysisInfoOrErrors);
+
+	return Program(
+		dialect,
+		move(get<unique_ptr<Block>>(astOrErrors)),
+		NameDispenser(dialect, move(_usedNames), _nameCounter)
+	);
+}
+
 void Program::optimise(vector<string> const& _optimisationSteps)
 {
 	m_ast = applyOptimisationSteps(m_dialect, m_nameDispenser, move(m_ast), _optimisationSteps);
@@ -46,13 +46,6 @@ struct CodeWeights;
 
 }
 
-namespace std
-{
-
-std::ostream& operator<<(std::ostream& _outputStream, solidity::langutil::ErrorList const& _errors);
-
-}
-
 namespace solidity::phaser
 {
 
@@ -78,10 +71,21 @@ public:
 	Program operator=(Program&& program) = delete;
 
 	static std::variant<Program, langutil::ErrorList> load(langutil::CharStream& _sourceCode);
+	/// Loads the source code of a program that was already loaded with @a load() and then printed.
+	/// Unlike @a load(), does not disambiguate the program or apply any optimisation steps to it.
+	/// @a _usedNames and @a _nameCounter restore the state of the name dispenser of the printed
+	/// program so that further optimisation steps introduce the same names as they would into
+	/// the original one.
+	static std::variant<Program, langutil::ErrorList> loadPrepared(
+		langutil::CharStream& _sourceCode,
+		std::set<yul::YulString> _usedNames,
+		size_t _nameCounter
+	);
 	void optimise(std::vector<std::string> const& _optimisationSteps);
 
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(*m_ast, _weights); }
 	yul::Block const& ast() const { return *m_ast; }
+	yul::NameDispenser const& nameDispenser() const { return m_nameDispenser; }
 
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
 	std::string toJson() const;
@@ -95,6 +99,15 @@ private:
 		m_dialect{_dialect},
 		m_nameDispenser(_dialect, *m_ast, {})
 	{}
+	Program(
+		yul::Dialect const& _dialect,
+		std::unique_ptr<yul::Block> _ast,
+		yul::NameDispenser _nameDispenser
+	):
+		m_ast(std::move(_ast)),
+		m_dialect{_dialect},
+		m_nameDispenser(std::move(_nameDispenser))
+	{}
 
 	static std::variant<std::unique_ptr<yul::Block>, langutil::ErrorList> parseObject(
 		yul::Dialect const& _dialect,
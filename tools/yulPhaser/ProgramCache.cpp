@@ -18,11 +18,28 @@
 
 #include <tools/yulPhaser/ProgramCache.h>
 
+#include <tools/yulPhaser/Exceptions.h>
+
 #include <libyul/optimiser/Metrics.h>
 
 #include <libyul/optimiser/Suite.h>
 
+#include <libsolidity/interface/Version.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <iterator>
+#include <set>
+#include <vector>
+
 using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
 using namespace solidity::yul;
 using namespace solidity::phaser;
 
@@ -60,31 +77,35 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
+	shared_ptr<Program const> prefixProgram;
 	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+		lock_guard<mutex> lock(m_mutex);
+		for (size_t i = 1; i <= targetOptimisations.size(); ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				touch(pair->second);
+				prefixProgram = pair->second.program;
+				++prefixSize;
+				++m_hits;
+			}
+			else
+				break;
 		}
-		else
-			break;
 	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+	Program intermediateProgram = (prefixProgram ? *prefixProgram : m_program);
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		auto cachedProgram = make_shared<Program const>(intermediateProgram);
+		lock_guard<mutex> lock(m_mutex);
+		insert(targetOptimisations.substr(0, i), move(cachedProgram));
 		++m_misses;
 	}
 
@@ -96,12 +117,15 @@ void ProgramCache::startRound(size_t _roundNumber)
 	assert(_roundNumber > m_currentRound);
 	m_currentRound = _roundNumber;
 
+	if (m_sizeLimit.has_value())
+		return;
+
 	for (auto pair = m_entries.begin(); pair != m_entries.end();)
 	{
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			erase(pair++);
 		else
 			++pair;
 	}
@@ -110,35 +134,172 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_entriesByLastUse.clear();
+	m_totalSize = 0;
 	m_currentRound = 0;
 }
 
-Program const* ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
+size_t ProgramCache::size() const
 {
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+shared_ptr<Program const> ProgramCache::find(string const& _abbreviatedOptimisationSteps) const
+{
+	lock_guard<mutex> lock(m_mutex);
 	auto const& pair = m_entries.find(_abbreviatedOptimisationSteps);
 	if (pair == m_entries.end())
 		return nullptr;
 
-	return &(pair->second.program);
+	return pair->second.program;
+}
+
+map<string, CacheEntry> ProgramCache::entries() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_entries;
 }
 
 CacheStats ProgramCache::gatherStats() const
 {
+	lock_guard<mutex> lock(m_mutex);
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalSize,
 		/* roundEntryCounts = */ countRoundEntries(),
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
+void ProgramCache::store(ostream& _stream) const
 {
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
+	lock_guard<mutex> lock(m_mutex);
 
-	return size;
+	Json::Value entries(Json::objectValue);
+	for (auto const& [steps, entry]: m_entries)
+	{
+		Json::Value usedNames(Json::arrayValue);
+		for (YulString name: entry.program->nameDispenser().usedNames())
+			usedNames.append(name.str());
+
+		entries[steps]["code"] = toString(*entry.program);
+		entries[steps]["usedNames"] = move(usedNames);
+		entries[steps]["nameCounter"] = Json::UInt64(entry.program->nameDispenser().counter());
+	}
+
+	Json::Value output(Json::objectValue);
+	output["version"] = frontend::VersionString;
+	output["program"] = programHash().hex();
+	output["entries"] = move(entries);
+	_stream << jsonCompactPrint(output) << endl;
+}
+
+size_t ProgramCache::restore(istream& _stream)
+{
+	string text{istreambuf_iterator<char>(_stream), istreambuf_iterator<char>()};
+	Json::Value input;
+	string errors;
+	if (!jsonParseStrict(text, input, &errors) || !input.isObject())
+		BOOST_THROW_EXCEPTION(BadInput() << errinfo_comment("Invalid program cache: " + errors));
+
+	if (
+		input["version"] != frontend::VersionString ||
+		input["program"] != programHash().hex() ||
+		!input["entries"].isObject()
+	)
+		return 0;
+
+	// Load all the programs before adding any so that a broken cache does not leave
+	// a part of its entries behind.
+	vector<pair<string, shared_ptr<Program const>>> restoredEntries;
+	for (auto const& steps: input["entries"].getMemberNames())
+	{
+		Json::Value const& entry = input["entries"][steps];
+		if (
+			!entry.isObject() ||
+			!entry["code"].isString() ||
+			!entry["usedNames"].isArray() ||
+			!entry["nameCounter"].isUInt64()
+		)
+			BOOST_THROW_EXCEPTION(BadInput() << errinfo_comment(
+				"Invalid program cache entry for optimisation steps '" + steps + "'."
+			));
+
+		set<YulString> usedNames;
+		for (auto const& name: entry["usedNames"])
+		{
+			if (!name.isString())
+				BOOST_THROW_EXCEPTION(BadInput() << errinfo_comment(
+					"Invalid program cache entry for optimisation steps '" + steps + "'."
+				));
+			usedNames.insert(YulString(name.asString()));
+		}
+
+		CharStream sourceCode(entry["code"].asString(), "program-cache");
+		variant<Program, ErrorList> programOrErrors = Program::loadPrepared(
+			sourceCode,
+			move(usedNames),
+			static_cast<size_t>(entry["nameCounter"].asUInt64())
+		);
+		if (holds_alternative<ErrorList>(programOrErrors))
+			BOOST_THROW_EXCEPTION(InvalidProgram() << errinfo_comment(
+				"Invalid program in the program cache for optimisation steps '" + steps + "'."
+			));
+
+		restoredEntries.emplace_back(steps, make_shared<Program const>(move(get<Program>(programOrErrors))));
+	}
+
+	lock_guard<mutex> lock(m_mutex);
+	size_t restoredCount = 0;
+	for (auto& [steps, program]: restoredEntries)
+		if (m_entries.count(steps) == 0)
+		{
+			insert(steps, move(program));
+			++restoredCount;
+		}
+
+	return restoredCount;
+}
+
+h256 ProgramCache::programHash() const
+{
+	return keccak256(toString(m_program));
+}
+
+void ProgramCache::insert(string const& _abbreviatedOptimisationSteps, shared_ptr<Program const> _program)
+{
+	auto existingEntry = m_entries.find(_abbreviatedOptimisationSteps);
+	if (existingEntry != m_entries.end())
+	{
+		// Another thread has already added the same program.
+		touch(existingEntry->second);
+		return;
+	}
+
+	size_t size = _program->codeSize(CacheStats::StorageWeights);
+	m_entries.insert({_abbreviatedOptimisationSteps, {move(_program), m_currentRound, size, ++m_useCounter}});
+	m_entriesByLastUse.insert({m_useCounter, _abbreviatedOptimisationSteps});
+	m_totalSize += size;
+
+	if (m_sizeLimit.has_value())
+		while (m_totalSize > m_sizeLimit.value())
+			erase(m_entries.find(m_entriesByLastUse.begin()->second));
+}
+
+void ProgramCache::touch(CacheEntry& _entry)
+{
+	auto node = m_entriesByLastUse.extract(_entry.lastUse);
+	_entry.lastUse = ++m_useCounter;
+	node.key() = _entry.lastUse;
+	m_entriesByLastUse.insert(move(node));
+}
+
+void ProgramCache::erase(map<string, CacheEntry>::iterator _entry)
+{
+	m_entriesByLastUse.erase(_entry->second.lastUse);
+	m_totalSize -= _entry->second.size;
+	m_entries.erase(_entry);
 }
 
 map<size_t, size_t> ProgramCache::countRoundEntries() const
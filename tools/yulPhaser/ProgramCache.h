@@ -22,7 +22,14 @@
 
 #include <libyul/optimiser/Metrics.h>
 
+#include <libsolutil/FixedHash.h>
+
+#include <istream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
 #include <string>
 
 namespace solidity::phaser
@@ -34,12 +41,20 @@ namespace solidity::phaser
  */
 struct CacheEntry
 {
-	Program program;
+	/// Shared so that the program can be copied outside of the lock while other threads may
+	/// remove the entry.
+	std::shared_ptr<Program const> program;
 	size_t roundNumber;
+	/// Size of the program measured with @a CacheStats::StorageWeights.
+	size_t size;
+	/// Value of a counter that is incremented whenever an entry is used or added.
+	size_t lastUse;
 
-	CacheEntry(Program _program, size_t _roundNumber):
+	CacheEntry(std::shared_ptr<Program const> _program, size_t _roundNumber, size_t _size, size_t _lastUse):
 		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
+		roundNumber(_roundNumber),
+		size(_size),
+		lastUse(_lastUse) {}
 };
 
 /**
@@ -92,21 +107,34 @@ struct CacheStats
  * encountered in the current and the previous rounds. Entries older than that get removed to
  * conserve memory.
  *
+ * If the cache has a size limit, entries are not purged at the beginning of a round. Instead,
+ * the least recently used entries are removed whenever the total size of the cached programs
+ * (measured with @a CacheStats::StorageWeights) exceeds the limit.
+ *
+ * @a store() and @a restore() allow keeping the entries between runs. Stored entries are only
+ * restored into a cache for the same program and by the same version of the compiler.
+ * Restored programs are reparsed from their source code. The state of their name dispenser is
+ * stored along with them so that later optimisation steps give the same results as in
+ * the original run.
+ *
  * @a gatherStats() allows getting statistics useful for determining cache effectiveness.
  *
+ * @a optimiseProgram(), @a size(), @a find(), @a entries() and @a gatherStats() can be called
+ * concurrently from multiple threads. Programs are optimised outside of the lock so when two threads need the same missing
+ * prefix at the same time, both compute it and the hit and miss counts depend on the timing.
+ * @a startRound(), @a clear() and @a restore() must not run concurrently with any other
+ * member function.
+ *
  * The current strategy does speed things up (about 4:1 hit:miss ratio observed in my limited
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
- *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _sizeLimit = std::nullopt):
+		m_program(std::move(_program)),
+		m_sizeLimit(_sizeLimit) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -115,27 +143,54 @@ public:
 	void startRound(size_t _nextRoundNumber);
 	void clear();
 
-	size_t size() const { return m_entries.size(); }
-	Program const* find(std::string const& _abbreviatedOptimisationSteps) const;
+	size_t size() const;
+	/// @returns the cached program or nullptr. The program stays valid even if the entry is
+	/// removed by another thread afterwards.
+	std::shared_ptr<Program const> find(std::string const& _abbreviatedOptimisationSteps) const;
 	bool contains(std::string const& _abbreviatedOptimisationSteps) const { return find(_abbreviatedOptimisationSteps) != nullptr; }
 
 	CacheStats gatherStats() const;
 
-	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
+	/// Writes the source code of all cached programs and the state of their name dispensers
+	/// to @a _stream.
+	void store(std::ostream& _stream) const;
+	/// Adds the programs written by @a store() to the cache, unless they were stored for
+	/// a different program or by a different version of the compiler.
+	/// @returns the number of restored entries.
+	/// @throws BadInput if the stream does not contain a stored cache and InvalidProgram if
+	/// one of the stored programs is not valid. The cache is not modified in that case.
+	size_t restore(std::istream& _stream);
+
+	/// @returns a copy of the entries taken under the lock. The programs are shared, not copied.
+	std::map<std::string, CacheEntry> entries() const;
 	Program const& program() const { return m_program; }
+	/// @returns the hash of the source code of the program, used to identify stored entries.
+	util::h256 programHash() const;
+	std::optional<size_t> sizeLimit() const { return m_sizeLimit; }
 	size_t currentRound() const { return m_currentRound; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
+	/// Adds an entry and removes the least recently used ones if the cache exceeds the size limit.
+	/// Must be called with the lock held.
+	void insert(std::string const& _abbreviatedOptimisationSteps, std::shared_ptr<Program const> _program);
+	/// Marks @a _entry as the most recently used one. Must be called with the lock held.
+	void touch(CacheEntry& _entry);
+	void erase(std::map<std::string, CacheEntry>::iterator _entry);
 	std::map<size_t, size_t> countRoundEntries() const;
 
 	// The best matching data structure here would be a trie of chromosome prefixes but since
 	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
+	/// Keys of the entries by the value of their @a lastUse counter.
+	std::map<size_t, std::string> m_entriesByLastUse;
 
 	Program m_program;
+	std::optional<size_t> m_sizeLimit;
+	mutable std::mutex m_mutex;
 	size_t m_currentRound = 0;
+	size_t m_useCounter = 0;
+	size_t m_totalSize = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
 };